@@ -9,8 +9,13 @@
       'sources': [
         'src/binding.cpp',
         'src/create_string.cpp',
+        'src/css_optimizer.cpp',
         'src/custom_function_bridge.cpp',
         'src/custom_importer_bridge.cpp',
+        'src/file_system.cpp',
+        'src/include_path_index.cpp',
+        'src/native_importer.cpp',
+        'src/per_isolate.cpp',
         'src/sass_context_wrapper.cpp',
         'src/sass_types/boolean.cpp',
         'src/sass_types/color.cpp',
@@ -2,9 +2,12 @@
  * node-sass: lib/index.js
  */
 
-var path = require('path'),
+var fs = require('fs'),
+  path = require('path'),
+  crypto = require('crypto'),
   clonedeep = require('lodash.clonedeep'),
   assign = require('lodash.assign'),
+  prefetch = require('./prefetch'),
   sass = require('./extensions');
 
 /**
@@ -13,6 +16,12 @@ var path = require('path'),
 
 var binding = require('./binding')(sass);
 
+/**
+ * Pending async renders, keyed by getRenderKey()
+ */
+
+var inflight = {};
+
 /**
  * Get input file
  *
@@ -182,7 +191,10 @@ function buildIncludePaths(options) {
  */
 
 function getOptions(opts, cb) {
-  var options = clonedeep(opts || {});
+  var options = clonedeep(assign({}, opts, { data: null }));
+
+  // the binding only reads the source, so a Buffer does not need to be cloned
+  options.data = opts && opts.data;
 
   options.sourceComments = options.sourceComments || false;
   if (options.hasOwnProperty('file')) {
@@ -207,6 +219,47 @@ function getOptions(opts, cb) {
   return options;
 }
 
+/**
+ * Get a key identifying the compile described by the options
+ *
+ * Renders with the same key produce the same result, so concurrent
+ * ones can share a single compile when `coalesce` is set. Files are
+ * keyed by path, not contents. Options carrying importers or custom
+ * functions are never shared since their output depends on the
+ * callbacks.
+ *
+ * @param {Object} options
+ * @api private
+ */
+
+function getRenderKey(options) {
+  if (!options.coalesce || options.importer || options.functions || (!options.data && !options.file)) {
+    return null;
+  }
+
+  return JSON.stringify([
+    options.file,
+    options.data ? crypto.createHash('sha1').update(options.data).digest('hex') : null,
+    options.outFile,
+    options.importAliases || null,
+    options.includePaths,
+    options.indentedSyntax || false,
+    options.indentType,
+    options.indentWidth,
+    options.linefeed,
+    options.nodeModules || false,
+    options.omitSourceMapUrl || false,
+    options.optimize || false,
+    options.precision,
+    options.sourceComments,
+    options.sourceMap,
+    options.sourceMapContents || false,
+    options.sourceMapEmbed || false,
+    options.sourceMapRoot || null,
+    options.style
+  ]);
+}
+
 /**
  * Executes a callback and transforms any exception raised into a sass error
  *
@@ -277,61 +330,82 @@ function normalizeFunctionSignature(signature, callback) {
 
 module.exports.render = function(opts, cb) {
   var options = getOptions(opts, cb);
+  var key = getRenderKey(options);
 
-  // options.error and options.success are for libsass binding
-  options.error = function(err) {
-    var payload = assign(new Error(), JSON.parse(err));
+  // attach to an identical compile which is already running
+  if (key !== null) {
+    if (inflight[key]) {
+      inflight[key].push(options.context);
+      return;
+    }
+
+    inflight[key] = [options.context];
+  }
+
+  // every caller waiting on this compile receives the same payload
+  function complete(err, payload) {
+    var contexts = [options.context];
 
-    if (cb) {
-      options.context.callback.call(options.context, payload, null);
+    if (key !== null) {
+      contexts = inflight[key];
+      delete inflight[key];
     }
+
+    contexts.forEach(function(context) {
+      if (context.callback) {
+        context.callback.call(context, err, payload);
+      }
+    });
+  }
+
+  // options.error and options.success are for libsass binding
+  options.error = function(err) {
+    complete(assign(new Error(), JSON.parse(err)), null);
   };
 
   options.success = function() {
     var result = options.result;
     var stats = endStats(result.stats);
-    var payload = {
+
+    complete(null, {
       css: result.css,
       map: result.map,
       stats: stats
-    };
-
-    if (cb) {
-      options.context.callback.call(options.context, null, payload);
-    }
+    });
   };
 
   var importer = options.importer;
+  var importers = importer ? [].concat(importer) : [];
+  var prefetched = null;
 
-  if (importer) {
-    if (Array.isArray(importer)) {
-      options.importer = [];
-      importer.forEach(function(subject, index) {
-        options.importer[index] = function(file, prev, bridge) {
-          function done(result) {
-            bridge.success(result === module.exports.NULL ? null : result);
-          }
+  function callImporter(index, file, prev, done) {
+    var result = importers[index].call(options.context, file, prev, done);
+
+    if (result !== undefined) {
+      done(result);
+    }
+  }
 
-          var result = subject.call(options.context, file, prev, done);
+  function importerCallback(index) {
+    return function(file, prev, bridge) {
+      var cacheKey = file + '\0' + prev;
 
-          if (result !== undefined) {
-            done(result);
-          }
-        };
-      });
-    } else {
-      options.importer = function(file, prev, bridge) {
-        function done(result) {
-          bridge.success(result === module.exports.NULL ? null : result);
-        }
+      function done(result) {
+        bridge.success(result === module.exports.NULL ? null : result);
+      }
 
-        var result = importer.call(options.context, file, prev, done);
+      if (prefetched && prefetched[index].hasOwnProperty(cacheKey)) {
+        return done(prefetched[index][cacheKey]);
+      }
 
-        if (result !== undefined) {
-          done(result);
-        }
-      };
-    }
+      callImporter(index, file, prev, done);
+    };
+  }
+
+  if (importer) {
+    options.importer = Array.isArray(importer) ? importers.map(function(subject, index) {
+      return importerCallback(index);
+    }) : importerCallback(0);
   }
 
   var functions = clonedeep(options.functions);
@@ -359,12 +433,133 @@ module.exports.render = function(opts, cb) {
     });
   }
 
-  if (options.data) {
-    binding.render(options);
-  } else if (options.file) {
-    binding.renderFile(options);
+  function compile() {
+    try {
+      if (options.data) {
+        binding.render(options);
+      } else if (options.file) {
+        binding.renderFile(options);
+      } else {
+        cb({status: 3, message: 'No input specified: provide a file name or a source string to process' });
+      }
+    } catch (e) {
+      // the compile never started, release renders which attached to it
+      if (key !== null) {
+        var waiting = inflight[key].slice(1);
+
+        delete inflight[key];
+        waiting.forEach(function(context) {
+          if (context.callback) {
+            context.callback.call(context, e, null);
+          }
+        });
+      }
+
+      throw e;
+    }
+  }
+
+  if (options.prefetchImports && importers.length && (options.data || options.file)) {
+    prefetch(options, importers.length, function(index, file, prev, done) {
+      callImporter(index, file, prev, function(result) {
+        done(result === module.exports.NULL ? null : result);
+      });
+    }, function(caches) {
+      prefetched = caches;
+      compile();
+    });
   } else {
-    cb({status: 3, message: 'No input specified: provide a file name or a source string to process' });
+    compile();
+  }
+};
+
+/**
+ * Get the variable declarations which start a variant
+ *
+ * SCSS declarations are kept on one line so line numbers of the
+ * stylesheet are not shifted.
+ *
+ * @param {Object} vars
+ * @param {Boolean} indentedSyntax
+ * @api private
+ */
+
+function getVariantPrelude(vars, indentedSyntax) {
+  return Object.keys(vars || {}).map(function(name) {
+    var declaration = '$' + name.replace(/^\$/, '') + ': ' + vars[name];
+
+    return indentedSyntax ? declaration + '\n' : declaration + '; ';
+  }).join('');
+}
+
+/**
+ * Render variants
+ *
+ * Reads the entry once and compiles it for every set of variables, with
+ * the variables declared before the stylesheet so they override its
+ * `!default` values. Variants compile concurrently on the libuv thread pool.
+ *
+ * @param {Object} opts
+ * @param {Array} variants - objects mapping variable names to Sass values
+ * @param {Function} cb - function(err, results)
+ * @api public
+ */
+
+module.exports.renderVariants = function(opts, variants, cb) {
+  var results = new Array(variants.length),
+    pending = variants.length,
+    failed = false,
+    indentedSyntax = opts.indentedSyntax || /\.sass$/i.test(opts.file || '');
+
+  // errors which never reach LibSass take the shape of the ones it reports
+  function fail(message) {
+    cb(assign(new Error(), {
+      status: 3,
+      file: opts.file,
+      message: message,
+      formatted: 'Error: ' + message + '\n'
+    }));
+  }
+
+  function compile(source) {
+    if (pending === 0) {
+      return cb(null, results);
+    }
+
+    // the declarations go first, a byte order mark after them is a syntax error
+    source = source.replace(/^\uFEFF/, '');
+
+    variants.forEach(function(vars, index) {
+      module.exports.render(assign({}, opts, {
+        data: getVariantPrelude(vars, indentedSyntax) + source,
+        indentedSyntax: indentedSyntax
+      }), function(err, result) {
+        if (failed) {
+          return;
+        }
+
+        if (err) {
+          failed = true;
+          return cb(err);
+        }
+
+        results[index] = result;
+
+        if (--pending === 0) {
+          cb(null, results);
+        }
+      });
+    });
+  }
+
+  if (opts.data) {
+    compile(String(opts.data));
+  } else if (opts.file) {
+    fs.readFile(opts.file, 'utf8', function(err, source) {
+      return err ? fail('File to read not found or unreadable: ' + opts.file) : compile(source);
+    });
+  } else {
+    fail('No input specified: provide a file name or a source string to process');
   }
 };
 
@@ -431,6 +626,16 @@ module.exports.renderSync = function(opts) {
   throw assign(new Error(), JSON.parse(result.error));
 };
 
+/**
+ * Clear the directory index used by the `includePathCache` option
+ *
+ * @api public
+ */
+
+module.exports.clearIncludePathCache = function() {
+  binding.clearIncludePathCache();
+};
+
 /**
  * API Info
  *
@@ -0,0 +1,266 @@
+/*!
+ * node-sass: lib/prefetch.js
+ */
+
+var fs = require('fs'),
+  path = require('path');
+
+/**
+ * Strip comments from a source and empty the string literals which are not
+ * part of an `@import` directive
+ *
+ * Unquoted `url()` arguments are kept as they are, so a `//` in them is not
+ * taken for a comment.
+ *
+ * @param {String} source
+ * @api private
+ */
+
+function stripSource(source) {
+  var out = '',
+    inImport = false,
+    i = 0,
+    end,
+    c;
+
+  while (i < source.length) {
+    c = source[i];
+
+    if (c === '/' && source[i + 1] === '*') {
+      end = source.indexOf('*/', i + 2);
+      i = end === -1 ? source.length : end + 2;
+      out += ' ';
+    } else if (c === '/' && source[i + 1] === '/') {
+      end = source.indexOf('\n', i);
+      i = end === -1 ? source.length : end;
+    } else if (c === '"' || c === '\'') {
+      for (end = i + 1; end < source.length && source[end] !== c && source[end] !== '\n'; end++) {
+        if (source[end] === '\\') {
+          end++;
+        }
+      }
+      out += inImport ? source.slice(i, end + 1) : c + c;
+      i = end + 1;
+    } else if (/^url\([^'"]/i.test(source.substr(i, 5))) {
+      end = source.indexOf(')', i);
+      end = end === -1 ? source.length : end + 1;
+      out += source.slice(i, end);
+      i = end;
+    } else if (source.substr(i, 7) === '@import') {
+      inImport = true;
+      out += '@import';
+      i += 7;
+    } else {
+      if (c === ';' || c === '\n' || c === '{' || c === '}') {
+        inImport = false;
+      }
+      out += c;
+      i++;
+    }
+  }
+
+  return out;
+}
+
+/**
+ * Get the urls of all `@import` directives found in a source
+ *
+ * Plain css imports are skipped since LibSass never hands them
+ * over to an importer that would resolve them.
+ *
+ * @param {String} source
+ * @api private
+ */
+
+function getImportUrls(source) {
+  var urls = [],
+    directive = /@import\s+([^;\n]+)/g,
+    quoted = /"([^"]*)"|'([^']*)'/g,
+    match,
+    url;
+
+  source = stripSource(source);
+
+  while ((match = directive.exec(source))) {
+    if (/url\(/.test(match[1])) {
+      continue;
+    }
+
+    while ((url = quoted.exec(match[1]))) {
+      url = url[1] !== undefined ? url[1] : url[2];
+
+      if (!/\.css$|^https?:\/\/|^\/\//.test(url)) {
+        urls.push(url);
+      }
+    }
+  }
+
+  return urls;
+}
+
+/**
+ * Get the candidate file names LibSass probes for an import
+ *
+ * @param {String} url
+ * @api private
+ */
+
+function getImportCandidates(url) {
+  var dir = path.dirname(url),
+    name = path.basename(url);
+
+  return [
+    name,
+    '_' + name,
+    '_' + name + '.scss',
+    '_' + name + '.sass',
+    '_' + name + '.css',
+    name + '.scss',
+    name + '.sass',
+    name + '.css'
+  ].map(function(candidate) {
+    return path.join(dir, candidate);
+  });
+}
+
+/**
+ * Find the file an import resolves to on disk
+ *
+ * @param {String} url
+ * @param {String} prev
+ * @param {Array} includePaths
+ * @param {Function} cb
+ * @api private
+ */
+
+function findImport(url, prev, includePaths, cb) {
+  var candidates = [];
+
+  [path.dirname(prev)].concat(includePaths).forEach(function(dir) {
+    getImportCandidates(url).forEach(function(candidate) {
+      candidates.push(path.resolve(dir, candidate));
+    });
+  });
+
+  (function next(i) {
+    if (i >= candidates.length) {
+      return cb(null);
+    }
+
+    fs.stat(candidates[i], function(err, stats) {
+      if (!err && stats.isFile()) {
+        return cb(candidates[i]);
+      }
+
+      next(i + 1);
+    });
+  })(0);
+}
+
+/**
+ * Prefetch the importer responses of a compile
+ *
+ * Walks the import graph of the entry and asks the importers about every
+ * import as soon as it is discovered, so asynchronous importers resolve
+ * concurrently instead of one `@import` at a time. Importers are consulted
+ * in order until one handles the import, like LibSass does. Files resolved
+ * from disk are read and scanned as well.
+ *
+ * The callback receives one cache per importer, mapping `url + '\0' + prev`
+ * to the response.
+ *
+ * @param {Object} options
+ * @param {Number} count - number of importers
+ * @param {Function} callImporter - function(index, url, prev, done)
+ * @param {Function} cb
+ * @api public
+ */
+
+module.exports = function(options, count, callImporter, cb) {
+  var caches = [],
+    seen = {},
+    pending = 1,
+    includePaths = options.includePaths.split(path.delimiter).filter(Boolean),
+    i;
+
+  for (i = 0; i < count; i++) {
+    caches.push({});
+  }
+
+  function finish() {
+    if (--pending === 0) {
+      cb(caches);
+    }
+  }
+
+  function scanFile(file) {
+    fs.readFile(file, 'utf8', function(err, source) {
+      if (!err) {
+        scan(source, file);
+      }
+
+      finish();
+    });
+  }
+
+  function scan(source, prev) {
+    getImportUrls(source).forEach(function(url) {
+      var key = url + '\0' + prev;
+
+      if (!seen[key]) {
+        seen[key] = true;
+        pending++;
+        resolve(url, prev, key, 0);
+      }
+    });
+  }
+
+  function resolve(url, prev, key, index) {
+    if (index >= count) {
+      return findImport(url, prev, includePaths, function(file) {
+        return file ? scanFile(file) : finish();
+      });
+    }
+
+    var answered = false;
+
+    try {
+      callImporter(index, url, prev, function(result) {
+        if (answered) {
+          return;
+        }
+
+        answered = true;
+        caches[index][key] = result;
+
+        if (result === null || result === undefined) {
+          resolve(url, prev, key, index + 1);
+        } else if (result instanceof Error) {
+          finish();
+        } else if (result.contents !== undefined) {
+          scan(String(result.contents), result.file || url);
+          finish();
+        } else if (result.file) {
+          findImport(result.file, prev, includePaths, function(file) {
+            return file ? scanFile(file) : finish();
+          });
+        } else {
+          finish();
+        }
+      });
+    } catch (e) {
+      // leave it to the compile, which reports the exception as usual
+      if (!answered) {
+        answered = true;
+        finish();
+      }
+    }
+  }
+
+  if (options.data) {
+    scan(String(options.data), options.file || 'stdin');
+    finish();
+  } else {
+    scanFile(options.file);
+  }
+};
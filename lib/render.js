@@ -19,6 +19,7 @@ var chalk = require('chalk'),
 module.exports = function(options, emitter) {
   var renderOptions = {
     includePaths: options.includePath,
+    includePathCache: options.includePathCache,
     omitSourceMapUrl: options.omitSourceMapUrl,
     indentedSyntax: options.indentedSyntax,
     outFile: options.dest,
@@ -0,0 +1,256 @@
+/*!
+ * node-sass: lib/server.js
+ */
+
+var fs = require('fs'),
+  net = require('net');
+
+/**
+ * Call `cb` with every newline delimited JSON message read from a socket
+ *
+ * The socket is destroyed when a message is malformed.
+ *
+ * @param {net.Socket} socket
+ * @param {Function} cb
+ * @api private
+ */
+
+function readMessages(socket, cb) {
+  var buffered = '';
+
+  socket.setEncoding('utf8');
+  socket.on('data', function(data) {
+    var lines = (buffered + data).split('\n'),
+      messages = [];
+
+    buffered = lines.pop();
+
+    try {
+      lines.forEach(function(line) {
+        if (line) {
+          messages.push(JSON.parse(line));
+        }
+      });
+    } catch (e) {
+      return socket.destroy();
+    }
+
+    messages.forEach(function(message) {
+      if (message !== null && typeof message === 'object') {
+        cb(message);
+      }
+    });
+  });
+}
+
+/**
+ * Write a message to a socket
+ *
+ * @param {net.Socket} socket
+ * @param {String} type
+ * @param {*} data
+ * @api private
+ */
+
+function send(socket, type, data) {
+  var message = {};
+
+  message[type] = data;
+  socket.write(JSON.stringify(message) + '\n');
+}
+
+/**
+ * Options which are always handled by the local process
+ */
+
+var localOptions = ['-w', '--watch', '-h', '--help', '-v', '--version'];
+
+/**
+ * Forward a command line to the compile server given with `--connect`
+ *
+ * Output of the server is written to stdout and stderr and the process
+ * exits with the status of the compile. Returns false if the command line
+ * has to be run locally, in which case nothing has been done.
+ *
+ * @param {Array} argv
+ * @return {Boolean}
+ * @api public
+ */
+
+module.exports.forward = function(argv) {
+  var socketPath = null,
+    args = [],
+    exited = false,
+    i;
+
+  for (i = 0; i < argv.length; i++) {
+    if (argv[i] === '--connect') {
+      socketPath = argv[++i];
+    } else if (argv[i].indexOf('--connect=') === 0) {
+      socketPath = argv[i].slice('--connect='.length);
+    } else {
+      args.push(argv[i]);
+    }
+  }
+
+  if (!socketPath || args.some(function(arg) {
+    return localOptions.indexOf(arg) !== -1;
+  })) {
+    return false;
+  }
+
+  var socket = net.connect(socketPath);
+
+  socket.on('error', function(err) {
+    console.error('Could not reach the compile server at ' + socketPath + ': ' + err.message);
+    process.exit(1);
+  });
+
+  socket.on('close', function() {
+    if (!exited) {
+      console.error('The compile server closed the connection');
+      process.exit(1);
+    }
+  });
+
+  readMessages(socket, function(message) {
+    if (message.log !== undefined) {
+      console.log(message.log);
+    } else if (message.warn !== undefined) {
+      console.warn(message.warn);
+    } else if (message.error !== undefined) {
+      console.error(message.error);
+    } else if (message.stdin) {
+      var chunks = [];
+
+      process.stdin.setEncoding('utf8');
+      process.stdin.on('data', function(chunk) {
+        chunks.push(chunk);
+      });
+      process.stdin.on('end', function() {
+        send(socket, 'stdin', chunks.join(''));
+      });
+    } else if (message.exit !== undefined) {
+      exited = true;
+      process.exit(message.exit);
+    }
+  });
+
+  send(socket, 'request', {
+    cwd: process.cwd(),
+    argv: args,
+    env: { SASS_PATH: process.env.SASS_PATH },
+    isTTY: !!process.stdin.isTTY
+  });
+
+  return true;
+};
+
+/**
+ * Start a compile server
+ *
+ * Requests are handled one at a time, so the handler may change the
+ * working directory of the process for the duration of a request. The
+ * handler receives the request and a client with `send(type, data)`,
+ * `readStdin(cb)` and `exit(code)`, which ends the request.
+ *
+ * A socket file left behind by a server which is no longer running is
+ * replaced.
+ *
+ * @param {String} socketPath
+ * @param {Function} handler - function(request, client)
+ * @param {Function} cb - function(err, server)
+ * @api public
+ */
+
+module.exports.listen = function(socketPath, handler, cb) {
+  var queue = [],
+    busy = false;
+
+  function next() {
+    if (busy || !queue.length) {
+      return;
+    }
+
+    var item = queue.shift();
+
+    busy = true;
+    handler(item.request, item.client);
+  }
+
+  var server = net.createServer(function(socket) {
+    var closed = false,
+      finished = false,
+      onStdin = null;
+
+    var client = {
+      send: function(type, data) {
+        if (!closed) {
+          send(socket, type, data);
+        }
+      },
+      readStdin: function(cb) {
+        onStdin = cb;
+        client.send('stdin', true);
+      },
+      exit: function(code) {
+        if (finished) {
+          return;
+        }
+
+        finished = true;
+        client.send('exit', code);
+        socket.end();
+        busy = false;
+        next();
+      }
+    };
+
+    readMessages(socket, function(message) {
+      var request = message.request;
+
+      if (request && typeof request.cwd === 'string' && Array.isArray(request.argv)) {
+        queue.push({ request: request, client: client });
+        next();
+      } else if (typeof message.stdin === 'string' && onStdin) {
+        var stdin = onStdin;
+
+        onStdin = null;
+        stdin(message.stdin);
+      }
+    });
+
+    // a client going away must not take the server down
+    socket.on('error', function() {});
+    socket.on('close', function() {
+      closed = true;
+
+      if (onStdin) {
+        onStdin = null;
+        client.exit(1);
+      }
+    });
+  });
+
+  server.on('error', function(err) {
+    if (err.code !== 'EADDRINUSE') {
+      return cb(err);
+    }
+
+    net.connect(socketPath)
+      .on('connect', function() {
+        this.end();
+        cb(err);
+      })
+      .on('error', function() {
+        fs.unlinkSync(socketPath);
+        server.listen(socketPath);
+      });
+  });
+
+  server.listen(socketPath, function() {
+    cb(null, server);
+  });
+
+  return server;
+};
@@ -3,6 +3,9 @@
 #include "sass_context_wrapper.h"
 #include "custom_function_bridge.h"
 #include "create_string.h"
+#include "include_path_index.h"
+#include "native_importer.h"
+#include "per_isolate.h"
 #include "sass_types/factory.h"
 
 Sass_Import_List sass_importer(const char* cur_path, Sass_Importer_Entry cb, struct Sass_Compiler* comp)
@@ -19,6 +22,16 @@ Sass_Import_List sass_importer(const char* cur_path, Sass_Importer_Entry cb, str
   return bridge(argv);
 }
 
+Sass_Import_List sass_native_importer(const char* cur_path, Sass_Importer_Entry cb, struct Sass_Compiler* comp)
+{
+  void* cookie = sass_importer_get_cookie(cb);
+  struct Sass_Import* previous = sass_compiler_get_last_import(comp);
+  const char* prev_path = sass_import_get_abs_path(previous);
+  NativeImporter& importer = *(static_cast<NativeImporter*>(cookie));
+
+  return importer(cur_path, prev_path);
+}
+
 union Sass_Value* sass_custom_function(const union Sass_Value* s_args, Sass_Function_Entry cb, struct Sass_Compiler* comp)
 {
   void* cookie = sass_function_get_cookie(cb);
@@ -114,7 +127,13 @@ int ExtractOptions(v8::Local<v8::Object> options, void* cptr, sass_context_wrapp
   sass_option_set_indent(sass_options, ctx_w->indent);
   sass_option_set_linefeed(sass_options, ctx_w->linefeed);
 
+  // the optimizer does not update source maps
+  ctx_w->optimize = Nan::To<bool>(Nan::Get(options, Nan::New("optimize").ToLocalChecked()).ToLocalChecked()).FromJust() &&
+                    sass_option_get_output_style(sass_options) == SASS_STYLE_COMPRESSED &&
+                    !ctx_w->source_map;
+
   v8::Local<v8::Value> importer_callback = Nan::Get(options, Nan::New("importer").ToLocalChecked()).ToLocalChecked();
+  std::vector<Sass_Importer_Entry> c_importers;
 
   if (importer_callback->IsFunction()) {
     v8::Local<v8::Function> importer = importer_callback.As<v8::Function>();
@@ -122,14 +141,10 @@ int ExtractOptions(v8::Local<v8::Object> options, void* cptr, sass_context_wrapp
     CustomImporterBridge *bridge = new CustomImporterBridge(importer, ctx_w->is_sync);
     ctx_w->importer_bridges.push_back(bridge);
 
-    Sass_Importer_List c_importers = sass_make_importer_list(1);
-    c_importers[0] = sass_make_importer(sass_importer, 0, bridge);
-
-    sass_option_set_c_importers(sass_options, c_importers);
+    c_importers.push_back(sass_make_importer(sass_importer, 0, bridge));
   }
   else if (importer_callback->IsArray()) {
     v8::Local<v8::Array> importers = importer_callback.As<v8::Array>();
-    Sass_Importer_List c_importers = sass_make_importer_list(importers->Length());
 
     for (size_t i = 0; i < importers->Length(); ++i) {
       v8::Local<v8::Function> callback = v8::Local<v8::Function>::Cast(Nan::Get(importers, static_cast<uint32_t>(i)).ToLocalChecked());
@@ -137,10 +152,47 @@ int ExtractOptions(v8::Local<v8::Object> options, void* cptr, sass_context_wrapp
       CustomImporterBridge *bridge = new CustomImporterBridge(callback, ctx_w->is_sync);
       ctx_w->importer_bridges.push_back(bridge);
 
-      c_importers[i] = sass_make_importer(sass_importer, importers->Length() - i - 1, bridge);
+      c_importers.push_back(sass_make_importer(sass_importer, importers->Length() - i - 1, bridge));
+    }
+  }
+
+  bool include_path_cache = Nan::To<bool>(Nan::Get(options, Nan::New("includePathCache").ToLocalChecked()).ToLocalChecked()).FromJust();
+  bool node_modules = Nan::To<bool>(Nan::Get(options, Nan::New("nodeModules").ToLocalChecked()).ToLocalChecked()).FromJust();
+  v8::Local<v8::Value> import_aliases = Nan::Get(options, Nan::New("importAliases").ToLocalChecked()).ToLocalChecked();
+
+  if (include_path_cache || node_modules || import_aliases->IsObject()) {
+    ctx_w->native_importer = new NativeImporter(ctx_w->include_path, include_path_cache, node_modules);
+
+    if (import_aliases->IsObject()) {
+      v8::Local<v8::Object> aliases = import_aliases.As<v8::Object>();
+      v8::Local<v8::Array> prefixes = Nan::GetOwnPropertyNames(aliases).ToLocalChecked();
+
+      for (unsigned i = 0; i < prefixes->Length(); i++) {
+        v8::Local<v8::Value> prefix = Nan::Get(prefixes, i).ToLocalChecked();
+        char* alias = create_string(prefix);
+        char* target = create_string(Nan::Get(aliases, prefix));
+
+        if (alias && target) {
+          ctx_w->native_importer->add_alias(alias, target);
+        }
+
+        free(alias);
+        free(target);
+      }
+    }
+
+    // runs after all custom importers
+    c_importers.push_back(sass_make_importer(sass_native_importer, -1, ctx_w->native_importer));
+  }
+
+  if (!c_importers.empty()) {
+    Sass_Importer_List c_importer_list = sass_make_importer_list(c_importers.size());
+
+    for (size_t i = 0; i < c_importers.size(); ++i) {
+      c_importer_list[i] = c_importers[i];
     }
 
-    sass_option_set_c_importers(sass_options, c_importers);
+    sass_option_set_c_importers(sass_options, c_importer_list);
   }
 
   v8::Local<v8::Value> custom_functions = Nan::Get(options, Nan::New("functions").ToLocalChecked()).ToLocalChecked();
@@ -192,6 +244,14 @@ void GetStats(sass_context_wrapper* ctx_w, Sass_Context* ctx) {
       Nan::New("includedFiles").ToLocalChecked(),
       arr
     );
+
+    if (ctx_w->optimized_output) {
+      Nan::Set(
+        stats.As<v8::Object>(),
+        Nan::New("bytesSaved").ToLocalChecked(),
+        Nan::New<v8::Number>(static_cast<double>(strlen(sass_context_get_output_string(ctx)) - strlen(ctx_w->optimized_output)))
+      );
+    }
   } else {
     Nan::ThrowTypeError("\"result.stats\" element is not an object");
   }
@@ -207,15 +267,24 @@ int GetResult(sass_context_wrapper* ctx_w, Sass_Context* ctx, bool is_sync = fal
   assert(result->IsObject());
 
   if (status == 0) {
-    const char* css = sass_context_get_output_string(ctx);
-    const char* map = sass_context_get_source_map_string(ctx);
+    GetStats(ctx_w, ctx);
 
-    Nan::Set(result, Nan::New("css").ToLocalChecked(), Nan::CopyBuffer(css, static_cast<uint32_t>(strlen(css))).ToLocalChecked());
+    // take ownership of the output strings so the Buffers wrap them without
+    // another copy, they can be large with sourceMapContents
+    char* css = ctx_w->optimized_output;
+    char* map = sass_context_take_source_map_string(ctx);
 
-    GetStats(ctx_w, ctx);
+    if (css) {
+      ctx_w->optimized_output = 0;
+    }
+    else {
+      css = sass_context_take_output_string(ctx);
+    }
+
+    Nan::Set(result, Nan::New("css").ToLocalChecked(), Nan::NewBuffer(css, static_cast<uint32_t>(strlen(css))).ToLocalChecked());
 
     if (map) {
-      Nan::Set(result, Nan::New("map").ToLocalChecked(), Nan::CopyBuffer(map, static_cast<uint32_t>(strlen(map))).ToLocalChecked());
+      Nan::Set(result, Nan::New("map").ToLocalChecked(), Nan::NewBuffer(map, static_cast<uint32_t>(strlen(map))).ToLocalChecked());
     }
   }
   else if (is_sync) {
@@ -269,7 +338,7 @@ NAN_METHOD(render) {
 
   if (ExtractOptions(options, dctx, ctx_w, false, false) >= 0) { 
 
-    int status = uv_queue_work(uv_default_loop(), &ctx_w->request, compile_it, (uv_after_work_cb)MakeCallback);
+    int status = uv_queue_work(Nan::GetCurrentEventLoop(), &ctx_w->request, compile_it, (uv_after_work_cb)MakeCallback);
 
     assert(status == 0);
   }
@@ -286,6 +355,7 @@ NAN_METHOD(render_sync) {
 
   if ((result = ExtractOptions(options, dctx, ctx_w, false, true)) >= 0) {
     compile_data(dctx);
+    optimize_output(ctx_w);
     result = GetResult(ctx_w, ctx, true);
   }
 
@@ -302,7 +372,7 @@ NAN_METHOD(render_file) {
 
   if (ExtractOptions(options, fctx, ctx_w, true, false) >= 0) {
 
-    int status = uv_queue_work(uv_default_loop(), &ctx_w->request, compile_it, (uv_after_work_cb)MakeCallback);
+    int status = uv_queue_work(Nan::GetCurrentEventLoop(), &ctx_w->request, compile_it, (uv_after_work_cb)MakeCallback);
     assert(status == 0);
   }
 }
@@ -318,6 +388,7 @@ NAN_METHOD(render_file_sync) {
 
   if ((result = ExtractOptions(options, fctx, ctx_w, true, true)) >= 0) {
     compile_file(fctx);
+    optimize_output(ctx_w);
     result = GetResult(ctx_w, ctx, true);
   };
 
@@ -327,17 +398,39 @@ NAN_METHOD(render_file_sync) {
   info.GetReturnValue().Set(result == 0);
 }
 
+NAN_METHOD(clear_include_path_cache) {
+  IncludePathIndex::shared().clear();
+}
+
 NAN_METHOD(libsass_version) {
   info.GetReturnValue().Set(Nan::New<v8::String>(libsass_version()).ToLocalChecked());
 }
 
+#if NODE_MODULE_VERSION >= NODE_10_0_MODULE_VERSION
+static void DisposeIsolateState(void* arg) {
+  PerIsolateBase::dispose_all(static_cast<v8::Isolate*>(arg));
+}
+
+static PerIsolate<bool> cleanup_registered;
+#endif
+
 NAN_MODULE_INIT(RegisterModule) {
+#if NODE_MODULE_VERSION >= NODE_10_0_MODULE_VERSION
+  // worker threads each load the addon into their own isolate,
+  // release its handles when the environment goes away
+  if (!cleanup_registered.get()) {
+    cleanup_registered.get() = true;
+    node::AddEnvironmentCleanupHook(v8::Isolate::GetCurrent(), DisposeIsolateState, v8::Isolate::GetCurrent());
+  }
+#endif
+
   Nan::SetMethod(target, "render", render);
   Nan::SetMethod(target, "renderSync", render_sync);
   Nan::SetMethod(target, "renderFile", render_file);
   Nan::SetMethod(target, "renderFileSync", render_file_sync);
+  Nan::SetMethod(target, "clearIncludePathCache", clear_include_path_cache);
   Nan::SetMethod(target, "libsassVersion", libsass_version);
   SassTypes::Factory::initExports(target);
 }
 
-NODE_MODULE(binding, RegisterModule);
+NAN_MODULE_WORKER_ENABLED(binding, RegisterModule)
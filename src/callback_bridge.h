@@ -5,6 +5,7 @@
 #include <nan.h>
 #include <algorithm>
 #include <uv.h>
+#include "per_isolate.h"
 
 #define COMMA ,
 
@@ -24,7 +25,7 @@ class CallbackBridge {
     static void async_gone(uv_handle_t *handle);
     static NAN_METHOD(New);
     static NAN_METHOD(ReturnCallback);
-    static Nan::Persistent<v8::Function> wrapper_constructor;
+    static PerIsolate<Nan::Persistent<v8::Function>> wrapper_constructor;
     Nan::Persistent<v8::Object> wrapper;
 
     // The callback that will get called in the main thread after the worker thread used for the sass
@@ -51,7 +52,7 @@ class CallbackBridge {
 };
 
 template <typename T, typename L>
-Nan::Persistent<v8::Function> CallbackBridge<T, L>::wrapper_constructor;
+PerIsolate<Nan::Persistent<v8::Function>> CallbackBridge<T, L>::wrapper_constructor;
 
 template <typename T, typename L>
 CallbackBridge<T, L>::CallbackBridge(v8::Local<v8::Function> callback, bool is_sync) : callback(new Nan::Callback(callback)), is_sync(is_sync) {
@@ -65,7 +66,7 @@ CallbackBridge<T, L>::CallbackBridge(v8::Local<v8::Function> callback, bool is_s
   if (!is_sync) {
     this->async = new uv_async_t;
     this->async->data = (void*) this;
-    uv_async_init(uv_default_loop(), this->async, (uv_async_cb) dispatched_async_uv_callback);
+    uv_async_init(Nan::GetCurrentEventLoop(), this->async, (uv_async_cb) dispatched_async_uv_callback);
   }
 
   v8::Local<v8::Function> func = CallbackBridge<T, L>::get_wrapper_constructor().ToLocalChecked();
@@ -197,7 +198,9 @@ NAN_METHOD(CallbackBridge<T COMMA L>::ReturnCallback) {
 template <typename T, typename L>
 Nan::MaybeLocal<v8::Function> CallbackBridge<T, L>::get_wrapper_constructor() {
   /* Uses handle scope created in the CallbackBridge<T, L> constructor */
-  if (wrapper_constructor.IsEmpty()) {
+  Nan::Persistent<v8::Function>& cons = wrapper_constructor.get();
+
+  if (cons.IsEmpty()) {
     v8::Local<v8::FunctionTemplate> tpl = Nan::New<v8::FunctionTemplate>(New);
     tpl->SetClassName(Nan::New("CallbackBridge").ToLocalChecked());
     tpl->InstanceTemplate()->SetInternalFieldCount(1);
@@ -206,10 +209,10 @@ Nan::MaybeLocal<v8::Function> CallbackBridge<T, L>::get_wrapper_constructor() {
       Nan::New<v8::FunctionTemplate>(ReturnCallback)
     );
 
-    wrapper_constructor.Reset(Nan::GetFunction(tpl).ToLocalChecked());
+    cons.Reset(Nan::GetFunction(tpl).ToLocalChecked());
   }
 
-  return Nan::New(wrapper_constructor);
+  return Nan::New(cons);
 }
 
 template <typename T, typename L>
@@ -5,8 +5,15 @@
 
 char* create_string(Nan::MaybeLocal<v8::Value> maybevalue) {
   v8::Local<v8::Value> value;
-  
+
   if (maybevalue.ToLocal(&value)) {
+    if (node::Buffer::HasInstance(value)) {
+      size_t len = node::Buffer::Length(value);
+      char *str = (char *)malloc(len + 1);
+      memcpy(str, node::Buffer::Data(value), len);
+      str[len] = '\0';
+      return str;
+    }
     if (value->IsNull() || !value->IsString()) {
       return 0;
     }
@@ -14,8 +21,11 @@ char* create_string(Nan::MaybeLocal<v8::Value> maybevalue) {
     return 0;
   }
 
-  v8::String::Utf8Value string(value);
-  char *str = (char *)malloc(string.length() + 1);
-  strcpy(str, *string);
+  // encode straight into the buffer handed over to libsass
+  // instead of going through an intermediate Utf8Value
+  ssize_t len = Nan::DecodeBytes(value, Nan::UTF8);
+  char *str = (char *)malloc(len + 1);
+  Nan::DecodeWrite(str, len, value, Nan::UTF8);
+  str[len] = '\0';
   return str;
 }
@@ -0,0 +1,428 @@
+#include <ctype.h>
+#include <set>
+#include <vector>
+#include "css_optimizer.h"
+
+struct Statement {
+  // selector or at-rule prelude, the raw text for statements without a block
+  std::string prelude;
+  std::string body;
+  bool has_block;
+};
+
+static std::string optimize_statements(const std::string&);
+
+// Returns the position right after the string or comment starting at `pos`.
+static size_t skip_literal(const std::string& css, size_t pos) {
+  char quote = css[pos];
+
+  if (quote == '"' || quote == '\'') {
+    for (++pos; pos < css.size() && css[pos] != quote; ++pos) {
+      if (css[pos] == '\\') ++pos;
+    }
+    return pos < css.size() ? pos + 1 : css.size();
+  }
+
+  size_t end = css.find("*/", pos + 2);
+  return end == std::string::npos ? css.size() : end + 2;
+}
+
+static bool is_literal_start(const std::string& css, size_t pos) {
+  return css[pos] == '"' || css[pos] == '\'' ||
+         (css[pos] == '/' && pos + 1 < css.size() && css[pos + 1] == '*');
+}
+
+static bool has_block(const std::string& css) {
+  for (size_t pos = 0; pos < css.size(); ) {
+    if (is_literal_start(css, pos)) {
+      pos = skip_literal(css, pos);
+    } else if (css[pos++] == '{') {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// Splits `css` on `delimiter` outside of strings, comments and parentheses.
+static std::vector<std::string> split(const std::string& css, char delimiter) {
+  std::vector<std::string> parts;
+  size_t start = 0;
+  int parens = 0;
+
+  for (size_t pos = 0; pos < css.size(); ) {
+    if (is_literal_start(css, pos)) {
+      pos = skip_literal(css, pos);
+      continue;
+    }
+
+    if (css[pos] == '(') parens++;
+    else if (css[pos] == ')') parens--;
+    else if (css[pos] == delimiter && parens == 0) {
+      parts.push_back(css.substr(start, pos - start));
+      start = pos + 1;
+    }
+    ++pos;
+  }
+
+  parts.push_back(css.substr(start));
+  return parts;
+}
+
+// Splits a stylesheet or a block of nested rules into its top level statements.
+static bool split_statements(const std::string& css, std::vector<Statement>& statements) {
+  size_t start = 0, pos = 0;
+  int parens = 0;
+
+  while (pos < css.size()) {
+    if (is_literal_start(css, pos)) {
+      size_t end = skip_literal(css, pos);
+
+      // keep standalone comments, like preserved license headers, on their own
+      if (pos == start && css[pos] == '/') {
+        Statement comment = { css.substr(pos, end - pos), "", false };
+        statements.push_back(comment);
+        start = end;
+      }
+      pos = end;
+      continue;
+    }
+
+    char c = css[pos];
+
+    if (c == '(') {
+      parens++;
+    }
+    else if (c == ')') {
+      parens--;
+    }
+    else if (c == ';' && parens == 0) {
+      Statement statement = { css.substr(start, pos + 1 - start), "", false };
+      statements.push_back(statement);
+      start = pos + 1;
+    }
+    else if (c == '{' && parens == 0) {
+      size_t end = pos + 1;
+      int depth = 1;
+
+      while (end < css.size() && depth > 0) {
+        if (is_literal_start(css, end)) {
+          end = skip_literal(css, end);
+          continue;
+        }
+        if (css[end] == '{') depth++;
+        else if (css[end] == '}') depth--;
+        ++end;
+      }
+
+      if (depth > 0) {
+        return false;
+      }
+
+      // drop whitespace left between statements, e.g. after a preserved comment
+      size_t prelude = css.find_first_not_of(" \t\r\n", start);
+      Statement statement = { css.substr(prelude, pos - prelude), css.substr(pos + 1, end - pos - 2), true };
+      statements.push_back(statement);
+      start = pos = end;
+      continue;
+    }
+    else if (c == '}') {
+      return false;
+    }
+
+    ++pos;
+  }
+
+  if (start < css.size()) {
+    Statement statement = { css.substr(start), "", false };
+    statements.push_back(statement);
+  }
+
+  return true;
+}
+
+static bool is_length_unit(std::string unit) {
+  static const char* units[] = {
+    "px", "em", "rem", "ex", "ch", "vw", "vh", "vmin", "vmax",
+    "cm", "mm", "q", "in", "pt", "pc", 0
+  };
+
+  for (size_t i = 0; i < unit.size(); ++i) {
+    unit[i] = tolower(unit[i]);
+  }
+
+  for (size_t i = 0; units[i]; ++i) {
+    if (unit == units[i]) return true;
+  }
+
+  return false;
+}
+
+static bool is_hex(char c) {
+  return isxdigit(static_cast<unsigned char>(c)) != 0;
+}
+
+static bool is_name_char(char c) {
+  return isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '_';
+}
+
+static std::string to_lower(std::string str) {
+  for (size_t i = 0; i < str.size(); ++i) {
+    str[i] = tolower(str[i]);
+  }
+
+  return str;
+}
+
+static std::string strip_vendor_prefix(const std::string& name) {
+  if (name.size() > 1 && name[0] == '-' && name[1] != '-') {
+    size_t end = name.find('-', 1);
+    if (end != std::string::npos) return name.substr(end + 1);
+  }
+
+  return name;
+}
+
+// Arguments of these are copied verbatim: a unitless zero is a number and not
+// a length in math functions, and urls and references are opaque.
+static bool is_verbatim_function(const std::string& function) {
+  static const char* functions[] = {
+    "calc", "min", "max", "clamp", "round", "mod", "rem", "sin", "cos", "tan",
+    "asin", "acos", "atan", "atan2", "pow", "sqrt", "hypot", "log", "exp",
+    "abs", "sign", "url", "var", "env", 0
+  };
+  std::string name = strip_vendor_prefix(to_lower(function));
+
+  for (size_t i = 0; functions[i]; ++i) {
+    if (name == functions[i]) return true;
+  }
+
+  return false;
+}
+
+// Shortens colors and zero lengths in a declaration value. Strings and the
+// arguments of math functions, url() and var() are copied verbatim.
+static std::string optimize_value(const std::string& prop, const std::string& value) {
+  std::string name = to_lower(prop);
+
+  // custom properties are opaque, legacy IE filters need six digit colors
+  // and IE rejects a unitless flex-basis in the flex shorthand
+  if (name.compare(0, 2, "--") == 0 || strip_vendor_prefix(name) == "filter" || strip_vendor_prefix(name) == "flex") {
+    return value;
+  }
+
+  std::string out;
+  size_t pos = 0;
+
+  while (pos < value.size()) {
+    char c = value[pos];
+    char prev = pos > 0 ? value[pos - 1] : ' ';
+
+    if (is_literal_start(value, pos)) {
+      size_t end = skip_literal(value, pos);
+      out.append(value, pos, end - pos);
+      pos = end;
+    }
+    else if (c == '(') {
+      size_t word = out.size();
+      while (word > 0 && is_name_char(out[word - 1])) --word;
+      std::string function = out.substr(word);
+
+      if (is_verbatim_function(function)) {
+        size_t end = pos + 1;
+        int depth = 1;
+
+        while (end < value.size() && depth > 0) {
+          if (is_literal_start(value, end)) {
+            end = skip_literal(value, end);
+            continue;
+          }
+          if (value[end] == '(') depth++;
+          else if (value[end] == ')') depth--;
+          ++end;
+        }
+
+        out.append(value, pos, end - pos);
+        pos = end;
+      } else {
+        out += c;
+        ++pos;
+      }
+    }
+    else if (c == '#' && !is_name_char(prev)) {
+      size_t end = pos + 1;
+      while (end < value.size() && is_name_char(value[end])) ++end;
+
+      bool shorten = end - pos == 7;
+      for (size_t i = pos + 1; shorten && i < end; i += 2) {
+        shorten = is_hex(value[i]) && tolower(value[i]) == tolower(value[i + 1]);
+      }
+
+      if (shorten) {
+        out += '#';
+        for (size_t i = pos + 1; i < end; i += 2) out += value[i];
+      } else {
+        out.append(value, pos, end - pos);
+      }
+      pos = end;
+    }
+    else if ((isdigit(static_cast<unsigned char>(c)) || c == '.') && prev != '.' &&
+             (!is_name_char(prev) || ((prev == '-' || prev == '+') && (pos < 2 || !is_name_char(value[pos - 2]))))) {
+      size_t end = pos;
+      bool zero = true;
+
+      while (end < value.size() && (isdigit(static_cast<unsigned char>(value[end])) || value[end] == '.')) {
+        if (value[end] != '0' && value[end] != '.') zero = false;
+        ++end;
+      }
+
+      size_t unit_end = end;
+      while (unit_end < value.size() && isalpha(static_cast<unsigned char>(value[unit_end]))) ++unit_end;
+
+      if (zero && end > pos && unit_end > end && is_length_unit(value.substr(end, unit_end - end))) {
+        // drop the sign of a negative zero as well
+        if (!out.empty() && (out[out.size() - 1] == '-' || out[out.size() - 1] == '+') &&
+            (out.size() == 1 || !is_name_char(out[out.size() - 2]))) {
+          out.erase(out.size() - 1);
+        }
+        out += '0';
+      } else {
+        out.append(value, pos, unit_end - pos);
+      }
+      pos = unit_end;
+    }
+    else {
+      out += c;
+      ++pos;
+    }
+  }
+
+  return out;
+}
+
+// Optimizes the values of a declaration block and drops declarations which
+// are repeated verbatim later in the block.
+static std::string optimize_declarations(const std::string& body) {
+  std::vector<std::string> declarations;
+  std::vector<std::string> parts = split(body, ';');
+
+  for (size_t i = 0; i < parts.size(); ++i) {
+    const std::string& part = parts[i];
+    if (part.empty()) continue;
+
+    std::vector<std::string> pair = split(part, ':');
+    size_t colon = pair.size() > 1 ? pair[0].size() : std::string::npos;
+
+    if (colon == std::string::npos) {
+      declarations.push_back(part);
+    } else {
+      std::string prop = part.substr(0, colon);
+      declarations.push_back(prop + ":" + optimize_value(prop, part.substr(colon + 1)));
+    }
+  }
+
+  std::set<std::string> seen;
+  std::vector<std::string> kept;
+
+  for (size_t i = declarations.size(); i-- > 0; ) {
+    if (seen.insert(declarations[i]).second) {
+      kept.push_back(declarations[i]);
+    }
+  }
+
+  std::string out;
+  for (size_t i = kept.size(); i-- > 0; ) {
+    if (!out.empty()) out += ';';
+    out += kept[i];
+  }
+
+  return out;
+}
+
+static bool is_rule(const Statement& statement) {
+  return statement.has_block && !statement.prelude.empty() && statement.prelude[0] != '@';
+}
+
+// A selector list is dropped entirely by browsers if any selector is unknown,
+// so only selectors made of type, class and id selectors and combinators are
+// grouped. Pseudo classes, pseudo elements and attribute selectors are not.
+static bool can_group(const std::string& selector) {
+  for (size_t i = 0; i < selector.size(); ++i) {
+    char c = selector[i];
+
+    if (!is_name_char(c) && c != '.' && c != '#' && c != '*' && c != ' ' &&
+        c != '>' && c != '+' && c != '~' && c != ',') {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static std::string optimize_statements(const std::string& css) {
+  std::vector<Statement> statements;
+
+  if (!split_statements(css, statements)) {
+    return css;
+  }
+
+  std::vector<Statement> merged;
+
+  for (size_t i = 0; i < statements.size(); ++i) {
+    Statement statement = statements[i];
+
+    if (is_rule(statement)) {
+      if (has_block(statement.body)) {
+        merged.push_back(statement);
+        continue;
+      }
+
+      statement.body = optimize_declarations(statement.body);
+
+      if (statement.body.empty()) {
+        continue;
+      }
+
+      if (!merged.empty() && is_rule(merged.back()) && !has_block(merged.back().body)) {
+        Statement& previous = merged.back();
+
+        if (previous.prelude == statement.prelude) {
+          previous.body = optimize_declarations(previous.body + ";" + statement.body);
+          continue;
+        }
+
+        if (previous.body == statement.body && can_group(previous.prelude) && can_group(statement.prelude)) {
+          previous.prelude += "," + statement.prelude;
+          continue;
+        }
+      }
+    }
+    else if (statement.has_block) {
+      statement.body = has_block(statement.body) ? optimize_statements(statement.body) : optimize_declarations(statement.body);
+    }
+
+    merged.push_back(statement);
+  }
+
+  std::string out;
+
+  for (size_t i = 0; i < merged.size(); ++i) {
+    out += merged[i].prelude;
+
+    if (merged[i].has_block) {
+      out += "{" + merged[i].body + "}";
+    }
+  }
+
+  return out;
+}
+
+std::string optimize_css(const std::string& css) {
+  // keep the trailing linefeed libsass emits
+  size_t end = css.find_last_not_of("\r\n");
+  if (end == std::string::npos) {
+    return css;
+  }
+
+  return optimize_statements(css.substr(0, end + 1)) + css.substr(end + 1);
+}
@@ -0,0 +1,19 @@
+#ifndef CSS_OPTIMIZER_H
+#define CSS_OPTIMIZER_H
+
+#include <string>
+
+// Further shrinks the compressed output of libsass. Only rewrites which keep
+// the cascade intact are applied:
+//
+//  * adjacent rules with the same selector are merged,
+//  * adjacent rules with the same declarations are grouped, unless a selector
+//    uses pseudo classes, pseudo elements or attribute selectors,
+//  * repeated identical declarations within a rule are dropped,
+//  * six digit hex colors are shortened and zero lengths lose their unit.
+//
+// Source maps are not adjusted, so callers must not optimize when one is
+// generated.
+std::string optimize_css(const std::string& css);
+
+#endif
@@ -52,11 +52,11 @@ SassImportList CustomImporterBridge::post_process_return_value(v8::Local<v8::Val
   return imports;
 }
 
-Sass_Import* CustomImporterBridge::check_returned_string(Nan::MaybeLocal<v8::Value> value, const char *msg) const
+Sass_Import* CustomImporterBridge::check_returned_string(Nan::MaybeLocal<v8::Value> value, const char *msg, bool allow_buffer) const
 {
     v8::Local<v8::Value> checked;
     if (value.ToLocal(&checked)) { 
-      if (!checked->IsUndefined() && !checked->IsString()) {
+      if (!checked->IsUndefined() && !checked->IsString() && !(allow_buffer && node::Buffer::HasInstance(checked))) {
         goto err;
       } else {
         return nullptr;
@@ -74,13 +74,15 @@ Sass_Import* CustomImporterBridge::get_importer_entry(const v8::Local<v8::Object
   auto returned_map = Nan::Get(object, Nan::New<v8::String>("map").ToLocalChecked());
   Sass_Import *err;
 
-  if ((err = check_returned_string(returned_file, "returned value of `file` must be a string")))
+  if ((err = check_returned_string(returned_file, "returned value of `file` must be a string", false)))
     return err;
 
-  if ((err = check_returned_string(returned_contents, "returned value of `contents` must be a string")))
+  // contents and map may be Buffers, create_string copies those
+  // once without decoding them into an intermediate string
+  if ((err = check_returned_string(returned_contents, "returned value of `contents` must be a string or a Buffer", true)))
     return err;
 
-  if ((err = check_returned_string(returned_map, "returned value of `returned_map` must be a string")))
+  if ((err = check_returned_string(returned_map, "returned value of `returned_map` must be a string or a Buffer", true)))
     return err;
 
   char* path = create_string(returned_file);
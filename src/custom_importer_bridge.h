@@ -14,7 +14,7 @@ class CustomImporterBridge : public CallbackBridge<SassImportList> {
 
   private:
     SassImportList post_process_return_value(v8::Local<v8::Value>) const;
-    Sass_Import* check_returned_string(Nan::MaybeLocal<v8::Value> value, const char *msg) const;
+    Sass_Import* check_returned_string(Nan::MaybeLocal<v8::Value> value, const char *msg, bool allow_buffer) const;
     Sass_Import* get_importer_entry(const v8::Local<v8::Object>&) const;
     std::vector<v8::Local<v8::Value>> pre_process_args(std::vector<void*>) const;
 };
@@ -0,0 +1,213 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <vector>
+#include "file_system.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <direct.h>
+#else
+#include <dirent.h>
+#include <unistd.h>
+#endif
+
+namespace FileSystem
+{
+#ifdef _WIN32
+  static std::wstring to_wide(const std::string& utf8) {
+    int len = MultiByteToWideChar(CP_UTF8, 0, utf8.c_str(), -1, NULL, 0);
+    std::vector<wchar_t> buffer(len > 0 ? len : 1);
+    MultiByteToWideChar(CP_UTF8, 0, utf8.c_str(), -1, &buffer[0], len);
+    return std::wstring(&buffer[0]);
+  }
+
+  static std::string to_utf8(const std::wstring& wide) {
+    int len = WideCharToMultiByte(CP_UTF8, 0, wide.c_str(), -1, NULL, 0, NULL, NULL);
+    std::vector<char> buffer(len > 0 ? len : 1);
+    WideCharToMultiByte(CP_UTF8, 0, wide.c_str(), -1, &buffer[0], len, NULL, NULL);
+    return std::string(&buffer[0]);
+  }
+#endif
+
+  static std::string to_forward_slashes(std::string path) {
+    for (size_t i = 0; i < path.size(); ++i) {
+      if (path[i] == '\\') path[i] = '/';
+    }
+    return path;
+  }
+
+  std::string current_directory() {
+#ifdef _WIN32
+    wchar_t* wd = _wgetcwd(NULL, 0);
+    if (!wd) return "";
+    std::string cwd = to_forward_slashes(to_utf8(wd));
+    free(wd);
+#else
+    char* wd = getcwd(NULL, 0);
+    if (!wd) return "";
+    std::string cwd(wd);
+    free(wd);
+#endif
+    return cwd;
+  }
+
+  bool is_absolute(const std::string& path) {
+#ifdef _WIN32
+    if (path.size() >= 2 && path[1] == ':') return true;
+    if (!path.empty() && path[0] == '\\') return true;
+#endif
+    return !path.empty() && path[0] == '/';
+  }
+
+  std::string dir_name(const std::string& path) {
+    size_t pos = to_forward_slashes(path).find_last_of('/');
+    return pos == std::string::npos ? "" : path.substr(0, pos + 1);
+  }
+
+  std::string join(const std::string& root, const std::string& path) {
+    if (root.empty() || is_absolute(path)) return path;
+    if (path.empty()) return root;
+    if (root[root.size() - 1] == '/' || root[root.size() - 1] == '\\') return root + path;
+    return root + "/" + path;
+  }
+
+  // Resolves `.` and `..` segments the same way libsass does for the paths it reports.
+  std::string canonicalize(const std::string& path) {
+    std::string normalized = to_forward_slashes(path);
+    std::vector<std::string> segments;
+    size_t start = 0;
+
+    while (start <= normalized.size()) {
+      size_t end = normalized.find('/', start);
+      if (end == std::string::npos) end = normalized.size();
+      std::string segment = normalized.substr(start, end - start);
+
+      if (segment == "..") {
+        if (!segments.empty() && segments.back() != ".." && !segments.back().empty()) {
+          segments.pop_back();
+        } else {
+          segments.push_back(segment);
+        }
+      } else if (segment != "." && !(segment.empty() && !segments.empty() && end != normalized.size())) {
+        segments.push_back(segment);
+      }
+
+      start = end + 1;
+    }
+
+    std::string result;
+    for (size_t i = 0; i < segments.size(); ++i) {
+      if (i > 0) result += "/";
+      result += segments[i];
+    }
+    return result;
+  }
+
+  bool directory_mtime(const std::string& path, int64_t& mtime) {
+#ifdef _WIN32
+    WIN32_FILE_ATTRIBUTE_DATA data;
+    if (!GetFileAttributesExW(to_wide(path).c_str(), GetFileExInfoStandard, &data)) return false;
+    if (!(data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) return false;
+
+    // 100ns intervals since 1601-01-01
+    ULARGE_INTEGER time;
+    time.LowPart = data.ftLastWriteTime.dwLowDateTime;
+    time.HighPart = data.ftLastWriteTime.dwHighDateTime;
+    mtime = (static_cast<int64_t>(time.QuadPart) - 116444736000000000LL) * 100;
+#else
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) return false;
+    if (!S_ISDIR(st.st_mode)) return false;
+#ifdef __APPLE__
+    mtime = static_cast<int64_t>(st.st_mtimespec.tv_sec) * 1000000000 + st.st_mtimespec.tv_nsec;
+#else
+    mtime = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+#endif
+#endif
+    return true;
+  }
+
+  bool is_file(const std::string& path) {
+#ifdef _WIN32
+    struct _stat st;
+    if (_wstat(to_wide(path).c_str(), &st) != 0) return false;
+    return (st.st_mode & _S_IFREG) != 0;
+#else
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) return false;
+    return S_ISREG(st.st_mode);
+#endif
+  }
+
+  bool list_files(const std::string& path, std::set<std::string>& files) {
+#ifdef _WIN32
+    WIN32_FIND_DATAW data;
+    HANDLE handle = FindFirstFileW(to_wide(join(path, "*")).c_str(), &data);
+    if (handle == INVALID_HANDLE_VALUE) return false;
+
+    do {
+      if (!(data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) {
+        files.insert(to_utf8(data.cFileName));
+      }
+    } while (FindNextFileW(handle, &data));
+
+    FindClose(handle);
+#else
+    DIR* dir = opendir(path.c_str());
+    if (!dir) return false;
+
+    while (struct dirent* entry = readdir(dir)) {
+      std::string name(entry->d_name);
+
+      if (name == "." || name == "..") continue;
+
+#ifdef _DIRENT_HAVE_D_TYPE
+      if (entry->d_type == DT_REG) {
+        files.insert(name);
+        continue;
+      }
+      if (entry->d_type != DT_LNK && entry->d_type != DT_UNKNOWN) continue;
+#endif
+      struct stat st;
+      if (stat(join(path, name).c_str(), &st) == 0 && S_ISREG(st.st_mode)) {
+        files.insert(name);
+      }
+    }
+
+    closedir(dir);
+#endif
+    return true;
+  }
+
+  char* read_file(const std::string& path) {
+#ifdef _WIN32
+    FILE* fd = _wfopen(to_wide(path).c_str(), L"rb");
+#else
+    FILE* fd = fopen(path.c_str(), "rb");
+#endif
+    if (!fd) return 0;
+
+    if (fseek(fd, 0, SEEK_END) != 0) {
+      fclose(fd);
+      return 0;
+    }
+
+    long size = ftell(fd);
+    if (size < 0 || fseek(fd, 0, SEEK_SET) != 0) {
+      fclose(fd);
+      return 0;
+    }
+
+    char* contents = (char*)malloc(size + 1);
+    if (contents && fread(contents, 1, size, fd) != (size_t)size) {
+      free(contents);
+      contents = 0;
+    }
+    fclose(fd);
+
+    if (contents) contents[size] = '\0';
+    return contents;
+  }
+}
@@ -0,0 +1,35 @@
+#ifndef FILE_SYSTEM_H
+#define FILE_SYSTEM_H
+
+#include <set>
+#include <string>
+#include <stdint.h>
+
+// Minimal file system helpers for the native importers. They run on the
+// sass worker thread, so they use the platform APIs directly instead of libuv.
+// All paths are UTF-8 encoded and use forward slashes.
+namespace FileSystem
+{
+  std::string current_directory();
+  bool is_absolute(const std::string&);
+  std::string dir_name(const std::string&);
+  std::string join(const std::string&, const std::string&);
+  std::string canonicalize(const std::string&);
+
+  // Retrieves the modification time of a directory in nanoseconds since the
+  // epoch, as precise as the file system records it. Fails if `path` does not
+  // exist or is not a directory.
+  bool directory_mtime(const std::string& path, int64_t& mtime);
+
+  // Checks whether `path` exists and is a regular file.
+  bool is_file(const std::string& path);
+
+  // Collects the names of the regular files directly contained in `path`.
+  bool list_files(const std::string& path, std::set<std::string>& files);
+
+  // Reads a whole file into a malloc'ed, null terminated buffer. Returns 0 if
+  // the file could not be read.
+  char* read_file(const std::string& path);
+}
+
+#endif
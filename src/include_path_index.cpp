@@ -0,0 +1,78 @@
+#include <ctime>
+#include "include_path_index.h"
+#include "file_system.h"
+
+// Constructed at load time: function local statics are not thread safe on
+// MSVC 2015 with /Zc:threadSafeInit- (see binding.gyp).
+static IncludePathIndex shared_index;
+
+IncludePathIndex::IncludePathIndex() {
+  uv_mutex_init(&this->mutex);
+}
+
+IncludePathIndex::~IncludePathIndex() {
+  uv_mutex_destroy(&this->mutex);
+}
+
+IncludePathIndex& IncludePathIndex::shared() {
+  return shared_index;
+}
+
+IncludePathIndex::Directory IncludePathIndex::scan(const std::string& dir) {
+  Directory directory;
+  time_t now = time(0);
+
+  directory.exists = FileSystem::directory_mtime(dir, directory.mtime) &&
+                     FileSystem::list_files(dir, directory.files);
+
+  // allow for file systems which only record seconds, or even two seconds
+  directory.racy = directory.exists && directory.mtime / 1000000000 + 2 >= now;
+  return directory;
+}
+
+std::vector<std::string> IncludePathIndex::find(const std::string& dir, const std::vector<std::string>& names, bool revalidate) {
+  std::vector<std::string> found;
+  bool stale = true;
+  int64_t mtime = 0;
+  bool exists = false;
+
+  // Touch the file system without holding the lock, other compiles may
+  // be resolving imports from directories that are already cached.
+  if (revalidate) {
+    exists = FileSystem::directory_mtime(dir, mtime);
+  }
+
+  uv_mutex_lock(&this->mutex);
+  std::map<std::string, Directory>::const_iterator it = this->directories.find(dir);
+  if (it != this->directories.end()) {
+    stale = revalidate && (it->second.racy || exists != it->second.exists || mtime != it->second.mtime);
+  }
+  uv_mutex_unlock(&this->mutex);
+
+  if (stale) {
+    Directory directory = scan(dir);
+
+    uv_mutex_lock(&this->mutex);
+    this->directories[dir] = directory;
+    uv_mutex_unlock(&this->mutex);
+  }
+
+  uv_mutex_lock(&this->mutex);
+  const Directory& directory = this->directories[dir];
+  if (directory.exists) {
+    for (size_t i = 0; i < names.size(); ++i) {
+      if (directory.files.count(names[i])) {
+        found.push_back(names[i]);
+      }
+    }
+  }
+  uv_mutex_unlock(&this->mutex);
+
+  return found;
+}
+
+void IncludePathIndex::clear() {
+  uv_mutex_lock(&this->mutex);
+  this->directories.clear();
+  uv_mutex_unlock(&this->mutex);
+}
@@ -0,0 +1,51 @@
+#ifndef INCLUDE_PATH_INDEX_H
+#define INCLUDE_PATH_INDEX_H
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include <uv.h>
+
+// Process wide cache of directory listings used to resolve imports without
+// probing every candidate file name with a separate stat call.
+//
+// Both hits and misses are answered from the cached listing. A listing is
+// re-read when the modification time of its directory changed, which is
+// checked at most once per compile (see NativeImporter), or after clear().
+// Listings of directories modified shortly before they were read are re-read
+// on every check, as a file added within the timestamp granularity of the
+// file system would not change the modification time.
+class IncludePathIndex {
+  public:
+    IncludePathIndex();
+    ~IncludePathIndex();
+
+    // Returns the entries of `names` which exist as regular files in `dir`,
+    // preserving their order. When `revalidate` is set the cached listing is
+    // compared against the current mtime of `dir` first.
+    std::vector<std::string> find(const std::string& dir, const std::vector<std::string>& names, bool revalidate);
+
+    // Drops all cached listings.
+    void clear();
+
+    static IncludePathIndex& shared();
+
+  private:
+    struct Directory {
+      Directory() : exists(false), racy(false), mtime(0) {}
+
+      bool exists;
+      bool racy;
+      int64_t mtime;
+      std::set<std::string> files;
+    };
+
+    static Directory scan(const std::string&);
+
+    uv_mutex_t mutex;
+    std::map<std::string, Directory> directories;
+};
+
+#endif
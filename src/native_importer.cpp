@@ -0,0 +1,244 @@
+#include <stdlib.h>
+#include <algorithm>
+#include "native_importer.h"
+#include "include_path_index.h"
+#include "file_system.h"
+
+#ifdef _WIN32
+#define PATH_DELIMITER ';'
+#else
+#define PATH_DELIMITER ':'
+#endif
+
+static bool starts_with(const std::string& str, const std::string& prefix) {
+  return str.compare(0, prefix.size(), prefix) == 0;
+}
+
+static bool ends_with(const std::string& str, const std::string& suffix) {
+  return str.size() >= suffix.size() && str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+// libsass emits these as plain css @import rules instead of loading them
+static bool is_css_import(const std::string& url) {
+  return ends_with(url, ".css") || starts_with(url, "http://") || starts_with(url, "https://") ||
+         starts_with(url, "//") || starts_with(url, "url(");
+}
+
+// Extracts a top level string property from the contents of a package.json.
+// Only what is needed to read the `sass` and `style` fields is supported.
+static bool get_package_field(const char* json, const std::string& field, std::string& value) {
+  int depth = 0;
+  bool is_key = false;
+  std::string key, token;
+
+  for (const char* p = json; *p; ++p) {
+    if (*p == '"') {
+      token.clear();
+      for (++p; *p && *p != '"'; ++p) {
+        if (*p == '\\' && *(p + 1)) ++p;
+        token += *p;
+      }
+      if (!*p) return false;
+
+      if (depth == 1 && is_key) {
+        key = token;
+      } else if (depth == 1 && key == field) {
+        value = token;
+        return true;
+      }
+      is_key = false;
+    }
+    else if (*p == '{' || *p == '[') {
+      if (++depth == 1) is_key = true;
+      key.clear();
+    }
+    else if (*p == '}' || *p == ']') {
+      --depth;
+      key.clear();
+    }
+    else if (*p == ',' && depth == 1) {
+      is_key = true;
+      key.clear();
+    }
+  }
+
+  return false;
+}
+
+static bool compare_prefix_length(const std::pair<std::string, std::string>& a, const std::pair<std::string, std::string>& b) {
+  return a.first.size() > b.first.size();
+}
+
+NativeImporter::NativeImporter(const char* include_path, bool resolve_include_paths, bool resolve_node_modules)
+  : cwd(FileSystem::current_directory()), resolve_include_paths(resolve_include_paths), resolve_node_modules(resolve_node_modules) {
+  std::string paths(include_path ? include_path : "");
+  size_t start = 0;
+
+  while (start < paths.size()) {
+    size_t end = paths.find(PATH_DELIMITER, start);
+    if (end == std::string::npos) end = paths.size();
+
+    if (end > start) {
+      this->include_paths.push_back(FileSystem::join(this->cwd, paths.substr(start, end - start)));
+    }
+    start = end + 1;
+  }
+}
+
+void NativeImporter::add_alias(const std::string& prefix, const std::string& target) {
+  if (prefix.empty()) {
+    return;
+  }
+
+  this->aliases.push_back(std::make_pair(prefix, FileSystem::join(this->cwd, target)));
+  std::stable_sort(this->aliases.begin(), this->aliases.end(), compare_prefix_length);
+}
+
+Sass_Import_List NativeImporter::operator()(const char* url, const char* prev) {
+  std::string path(url);
+  std::vector<std::string> found;
+
+  if (is_css_import(path)) {
+    return 0;
+  }
+
+  std::string base = FileSystem::join(this->cwd, FileSystem::dir_name(prev ? prev : ""));
+
+  bool aliased = this->resolve_alias(path, found);
+
+  if (!aliased && this->resolve_node_modules && starts_with(path, "~")) {
+    this->resolve_node_module(base, path.substr(1), found);
+  }
+  else if (!aliased && this->resolve_include_paths && !this->resolve(base, path, found)) {
+    for (size_t i = 0; i < this->include_paths.size(); ++i) {
+      if (this->resolve(this->include_paths[i], path, found)) {
+        break;
+      }
+    }
+  }
+
+  // let libsass report missing and ambiguous imports
+  if (found.size() != 1) {
+    return 0;
+  }
+
+  return this->load(found[0]);
+}
+
+bool NativeImporter::resolve_alias(const std::string& url, std::vector<std::string>& found) {
+  for (size_t i = 0; i < this->aliases.size(); ++i) {
+    const std::string& prefix = this->aliases[i].first;
+
+    if (starts_with(url, prefix) && (url.size() == prefix.size() || url[prefix.size()] == '/' || prefix[prefix.size() - 1] == '/')) {
+      std::string rest = url.substr(prefix.size());
+      if (!rest.empty() && rest[0] == '/') rest = rest.substr(1);
+
+      this->resolve(this->aliases[i].second, rest.empty() ? "index" : rest, found);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// Resolves `package` or `package/path`, where package may be scoped, from the
+// closest node_modules directory above `base`. A bare package name resolves to
+// the `sass` or `style` field of its package.json, or to its index file.
+bool NativeImporter::resolve_node_module(const std::string& base, const std::string& url, std::vector<std::string>& found) {
+  size_t name_end = url.find('/', starts_with(url, "@") ? url.find('/') + 1 : 0);
+  std::string name = url.substr(0, name_end);
+  std::string rest = name_end == std::string::npos ? "" : url.substr(name_end + 1);
+  std::string dir = FileSystem::canonicalize(base);
+  int64_t mtime;
+
+  if (dir.size() > 1 && dir[dir.size() - 1] == '/') {
+    dir.erase(dir.size() - 1);
+  }
+
+  if (name.empty() || name == "@") {
+    return false;
+  }
+
+  while (true) {
+    std::string package_dir = FileSystem::join(FileSystem::join(dir, "node_modules"), name);
+
+    if (FileSystem::directory_mtime(package_dir, mtime)) {
+      if (rest.empty()) {
+        std::string entry = "index";
+
+        if (char* json = FileSystem::read_file(FileSystem::join(package_dir, "package.json"))) {
+          if (!get_package_field(json, "sass", entry)) {
+            get_package_field(json, "style", entry);
+          }
+          free(json);
+        }
+
+        rest = entry;
+      }
+
+      return this->resolve(package_dir, rest, found);
+    }
+
+    std::string parent = FileSystem::dir_name(dir);
+    if (parent.size() > 1 && parent[parent.size() - 1] == '/' && parent[parent.size() - 2] != ':') {
+      parent.erase(parent.size() - 1);
+    }
+    if (parent.empty() || parent == dir) {
+      break;
+    }
+    dir = parent;
+  }
+
+  return false;
+}
+
+// Mirrors the candidate names libsass probes in File::resolve_includes.
+bool NativeImporter::resolve(const std::string& root, const std::string& url, std::vector<std::string>& found) {
+  std::string sub_dir = FileSystem::dir_name(url);
+  std::string name = url.substr(sub_dir.size());
+
+  if (name.empty()) {
+    return false;
+  }
+
+  std::vector<std::string> names;
+  names.push_back(name);
+  names.push_back("_" + name);
+  names.push_back("_" + name + ".scss");
+  names.push_back("_" + name + ".sass");
+  names.push_back("_" + name + ".css");
+  names.push_back(name + ".scss");
+  names.push_back(name + ".sass");
+  names.push_back(name + ".css");
+
+  std::string dir = FileSystem::canonicalize(FileSystem::join(root, sub_dir));
+  bool revalidate = this->validated.insert(dir).second;
+  std::vector<std::string> hits = IncludePathIndex::shared().find(dir, names, revalidate);
+
+  for (size_t i = 0; i < hits.size(); ++i) {
+    found.push_back(FileSystem::join(dir, hits[i]));
+  }
+
+  return !hits.empty();
+}
+
+// libsass only converts indented syntax when it reads a file itself, so
+// `.sass` partials are handed back by path. libsass then probes the candidate
+// names for that path again, which costs a few stat calls per import.
+Sass_Import_List NativeImporter::load(const std::string& path) const {
+  char* contents = 0;
+
+  if (ends_with(path, ".sass")) {
+    // the cached listing was outdated, fall back to libsass
+    if (!FileSystem::is_file(path)) {
+      return 0;
+    }
+  }
+  else if (!(contents = FileSystem::read_file(path))) {
+    return 0;
+  }
+
+  Sass_Import_List imports = sass_make_import_list(1);
+  imports[0] = sass_make_import_entry(path.c_str(), contents, 0);
+  return imports;
+}
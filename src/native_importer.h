@@ -0,0 +1,47 @@
+#ifndef NATIVE_IMPORTER_H
+#define NATIVE_IMPORTER_H
+
+#include <set>
+#include <string>
+#include <vector>
+#include <utility>
+#include <sass/functions.h>
+
+// An importer which runs entirely on the sass worker thread, so resolving an
+// import never waits for the event loop. Depending on the options it
+//
+//  * rewrites imports starting with a registered alias prefix,
+//  * resolves `~package/path` imports from node_modules directories,
+//  * resolves imports relative to the importing file and the include paths.
+//
+// Candidate files are probed the way libsass does, but the lookups are answered
+// from the shared IncludePathIndex. Imports it cannot resolve unambiguously are
+// left to libsass.
+class NativeImporter {
+  public:
+    NativeImporter(const char* include_path, bool resolve_include_paths, bool resolve_node_modules);
+
+    // Registers an alias, `target` is relative to the working directory.
+    void add_alias(const std::string& prefix, const std::string& target);
+
+    Sass_Import_List operator()(const char* url, const char* prev);
+
+  private:
+    bool resolve(const std::string& root, const std::string& url, std::vector<std::string>& found);
+    bool resolve_alias(const std::string& url, std::vector<std::string>& found);
+    bool resolve_node_module(const std::string& base, const std::string& url, std::vector<std::string>& found);
+    Sass_Import_List load(const std::string& path) const;
+
+    std::string cwd;
+    std::vector<std::string> include_paths;
+    bool resolve_include_paths;
+    bool resolve_node_modules;
+
+    // sorted by descending prefix length so the most specific alias wins
+    std::vector<std::pair<std::string, std::string>> aliases;
+
+    // directories whose cached listing was already checked during this compile
+    std::set<std::string> validated;
+};
+
+#endif
@@ -0,0 +1,34 @@
+#include "per_isolate.h"
+
+// PerIsolate instances are static members, constructed while the addon
+// is loaded, so the registry is never modified concurrently.
+std::vector<PerIsolateBase*>& PerIsolateBase::registry() {
+  static std::vector<PerIsolateBase*> instances;
+  return instances;
+}
+
+PerIsolateBase::PerIsolateBase() {
+  uv_mutex_init(&this->mutex);
+  registry().push_back(this);
+}
+
+PerIsolateBase::~PerIsolateBase() {
+  std::vector<PerIsolateBase*>& instances = registry();
+
+  for (std::vector<PerIsolateBase*>::iterator it = instances.begin(); it != instances.end(); ++it) {
+    if (*it == this) {
+      instances.erase(it);
+      break;
+    }
+  }
+
+  uv_mutex_destroy(&this->mutex);
+}
+
+void PerIsolateBase::dispose_all(v8::Isolate* isolate) {
+  std::vector<PerIsolateBase*>& instances = registry();
+
+  for (size_t i = 0; i < instances.size(); ++i) {
+    instances[i]->dispose(isolate);
+  }
+}
@@ -0,0 +1,74 @@
+#ifndef PER_ISOLATE_H
+#define PER_ISOLATE_H
+
+#include <map>
+#include <vector>
+#include <nan.h>
+#include <uv.h>
+
+// The addon can be loaded by several isolates at once (the main thread and any
+// number of worker threads), so V8 handles and the objects owning them must
+// not be shared process wide. PerIsolateBase keeps track of all such state so
+// it can be released when the environment of an isolate shuts down.
+class PerIsolateBase {
+  public:
+    PerIsolateBase();
+    virtual ~PerIsolateBase();
+
+    // Releases the state every PerIsolate instance holds for the isolate.
+    static void dispose_all(v8::Isolate*);
+
+  protected:
+    virtual void dispose(v8::Isolate*) =0;
+
+    uv_mutex_t mutex;
+
+  private:
+    static std::vector<PerIsolateBase*>& registry();
+};
+
+// Holds one default constructed T for each isolate, created on first use.
+// Must only be accessed from a thread which has entered the isolate.
+template <typename T>
+class PerIsolate : public PerIsolateBase {
+  public:
+    T& get();
+
+  protected:
+    void dispose(v8::Isolate*);
+
+  private:
+    std::map<v8::Isolate*, T*> instances;
+};
+
+template <typename T>
+T& PerIsolate<T>::get() {
+  v8::Isolate* isolate = v8::Isolate::GetCurrent();
+
+  uv_mutex_lock(&this->mutex);
+  T*& instance = this->instances[isolate];
+  if (!instance) {
+    instance = new T();
+  }
+  T& result = *instance;
+  uv_mutex_unlock(&this->mutex);
+
+  return result;
+}
+
+template <typename T>
+void PerIsolate<T>::dispose(v8::Isolate* isolate) {
+  T* instance = 0;
+
+  uv_mutex_lock(&this->mutex);
+  typename std::map<v8::Isolate*, T*>::iterator it = this->instances.find(isolate);
+  if (it != this->instances.end()) {
+    instance = it->second;
+    this->instances.erase(it);
+  }
+  uv_mutex_unlock(&this->mutex);
+
+  delete instance;
+}
+
+#endif
@@ -1,4 +1,6 @@
+#include <string.h>
 #include "sass_context_wrapper.h"
+#include "css_optimizer.h"
 
 extern "C" {
   using namespace std;
@@ -12,6 +14,30 @@ extern "C" {
     else if (ctx_w->fctx) {
       compile_file(ctx_w->fctx);
     }
+
+    optimize_output(ctx_w);
+  }
+
+  void optimize_output(sass_context_wrapper* ctx_w) {
+    struct Sass_Context* ctx;
+
+    if (!ctx_w->optimize) {
+      return;
+    }
+
+    if (ctx_w->dctx) {
+      ctx = sass_data_context_get_context(ctx_w->dctx);
+    }
+    else {
+      ctx = sass_file_context_get_context(ctx_w->fctx);
+    }
+
+    if (sass_context_get_error_status(ctx) == 0) {
+      std::string css = optimize_css(sass_context_get_output_string(ctx));
+
+      ctx_w->optimized_output = (char*)malloc(css.size() + 1);
+      memcpy(ctx_w->optimized_output, css.c_str(), css.size() + 1);
+    }
   }
 
   void compile_data(struct Sass_Data_Context* dctx) {
@@ -45,6 +71,7 @@ extern "C" {
     free(ctx_w->source_map);
     free(ctx_w->source_map_root);
     free(ctx_w->indent);
+    free(ctx_w->optimized_output);
 
     std::vector<CustomImporterBridge *>::iterator imp_it = ctx_w->importer_bridges.begin();
     while (imp_it != ctx_w->importer_bridges.end()) {
@@ -52,6 +79,8 @@ extern "C" {
       imp_it = ctx_w->importer_bridges.erase(imp_it);
       delete p;
     }
+    delete ctx_w->native_importer;
+
     std::vector<CustomFunctionBridge *>::iterator func_it = ctx_w->function_bridges.begin();
     while (func_it != ctx_w->function_bridges.end()) {
       CustomFunctionBridge* p = *func_it;
@@ -8,6 +8,7 @@
 #include <sass/context.h>
 #include "custom_function_bridge.h"
 #include "custom_importer_bridge.h"
+#include "native_importer.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -16,10 +17,13 @@ extern "C" {
   void compile_data(struct Sass_Data_Context* dctx);
   void compile_file(struct Sass_File_Context* fctx);
   void compile_it(uv_work_t* req);
+  struct sass_context_wrapper;
+  void optimize_output(struct sass_context_wrapper* ctx_w);
 
   struct sass_context_wrapper {
     // binding related
     bool is_sync;
+    bool optimize;
     void* cookie;
     char* file;
     char* include_path;
@@ -28,6 +32,7 @@ extern "C" {
     char* source_map_root;
     char* linefeed;
     char* indent;
+    char* optimized_output;
 
     // libsass related
     Sass_Data_Context* dctx;
@@ -44,6 +49,7 @@ extern "C" {
 
     std::vector<CustomFunctionBridge *> function_bridges;
     std::vector<CustomImporterBridge *> importer_bridges;
+    NativeImporter* native_importer;
   };
 
   struct sass_context_wrapper*      sass_make_context_wrapper(void);
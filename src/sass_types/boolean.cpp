@@ -3,20 +3,29 @@
 
 namespace SassTypes
 {
-  Nan::Persistent<v8::Function> Boolean::constructor;
-  bool Boolean::constructor_locked = false;
+  struct Boolean::Singletons {
+    Singletons() : instance_false(false), instance_true(true) {}
+
+    Boolean instance_false;
+    Boolean instance_true;
+  };
+
+  PerIsolate<Boolean::Singletons> Boolean::singletons;
+  PerIsolate<Nan::Persistent<v8::Function>> Boolean::constructor;
+  PerIsolate<bool> Boolean::constructor_locked;
 
   Boolean::Boolean(bool v) : value(v) {}
 
   Boolean& Boolean::get_singleton(bool v) {
-    static Boolean instance_false(false), instance_true(true);
-    return v ? instance_true : instance_false;
+    Singletons& instances = singletons.get();
+    return v ? instances.instance_true : instances.instance_false;
   }
 
   v8::Local<v8::Function> Boolean::get_constructor() {
     Nan::EscapableHandleScope scope;
     v8::Local<v8::Function> conslocal; 
-    if (constructor.IsEmpty()) {
+    Nan::Persistent<v8::Function>& cons = constructor.get();
+    if (cons.IsEmpty()) {
       v8::Local<v8::FunctionTemplate> tpl = Nan::New<v8::FunctionTemplate>(New);
 
       tpl->SetClassName(Nan::New("SassBoolean").ToLocalChecked());
@@ -24,7 +33,7 @@ namespace SassTypes
       Nan::SetPrototypeTemplate(tpl, "getValue", Nan::New<v8::FunctionTemplate>(GetValue));
 
       conslocal = Nan::GetFunction(tpl).ToLocalChecked();
-      constructor.Reset(conslocal);
+      cons.Reset(conslocal);
 
       get_singleton(false).js_object.Reset(Nan::NewInstance(conslocal).ToLocalChecked());
       Nan::SetInternalFieldPointer(Nan::New(get_singleton(false).js_object), 0, &get_singleton(false));
@@ -34,9 +43,9 @@ namespace SassTypes
       Nan::SetInternalFieldPointer(Nan::New(get_singleton(true).js_object), 0, &get_singleton(true));
       Nan::Set(conslocal, Nan::New("TRUE").ToLocalChecked(), Nan::New(get_singleton(true).js_object));
 
-      constructor_locked = true;
+      constructor_locked.get() = true;
     } else {
-      conslocal = Nan::New(constructor);
+      conslocal = Nan::New(cons);
     }
 
     return scope.Escape(conslocal);
@@ -53,7 +62,7 @@ namespace SassTypes
   NAN_METHOD(Boolean::New) {
 
     if (info.IsConstructCall()) {
-      if (constructor_locked) {
+      if (constructor_locked.get()) {
         return Nan::ThrowTypeError("Cannot instantiate SassBoolean");
       }
     }
@@ -2,6 +2,7 @@
 #define SASS_TYPES_BOOLEAN_H
 
 #include <nan.h>
+#include "../per_isolate.h"
 #include "value.h"
 #include "sass_value_wrapper.h"
 
@@ -24,8 +25,11 @@ namespace SassTypes
       bool value;
       Nan::Persistent<v8::Object> js_object;
 
-      static Nan::Persistent<v8::Function> constructor;
-      static bool constructor_locked;
+      struct Singletons;
+
+      static PerIsolate<Singletons> singletons;
+      static PerIsolate<Nan::Persistent<v8::Function>> constructor;
+      static PerIsolate<bool> constructor_locked;
   };
 }
 
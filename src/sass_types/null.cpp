@@ -3,35 +3,40 @@
 
 namespace SassTypes
 {
-  Nan::Persistent<v8::Function> Null::constructor;
-  bool Null::constructor_locked = false;
+  struct Null::Singleton {
+    Null instance;
+  };
+
+  PerIsolate<Null::Singleton> Null::singleton;
+  PerIsolate<Nan::Persistent<v8::Function>> Null::constructor;
+  PerIsolate<bool> Null::constructor_locked;
 
   Null::Null() {}
 
   Null& Null::get_singleton() {
-    static Null singleton_instance;
-    return singleton_instance;
+    return singleton.get().instance;
   }
 
   v8::Local<v8::Function> Null::get_constructor() {
     Nan::EscapableHandleScope scope;
     v8::Local<v8::Function> conslocal;
-    if (constructor.IsEmpty()) {
+    Nan::Persistent<v8::Function>& cons = constructor.get();
+    if (cons.IsEmpty()) {
       v8::Local<v8::FunctionTemplate> tpl = Nan::New<v8::FunctionTemplate>(New);
 
       tpl->SetClassName(Nan::New("SassNull").ToLocalChecked());
       tpl->InstanceTemplate()->SetInternalFieldCount(1);
 
       conslocal = Nan::GetFunction(tpl).ToLocalChecked();
-      constructor.Reset(conslocal);
+      cons.Reset(conslocal);
 
       get_singleton().js_object.Reset(Nan::NewInstance(conslocal).ToLocalChecked());
       Nan::SetInternalFieldPointer(Nan::New(get_singleton().js_object), 0, &get_singleton());
       Nan::Set(conslocal, Nan::New("NULL").ToLocalChecked(), Nan::New(get_singleton().js_object));
 
-      constructor_locked = true;
+      constructor_locked.get() = true;
     } else {
-      conslocal = Nan::New(constructor);
+      conslocal = Nan::New(cons);
     }
 
     return scope.Escape(conslocal);
@@ -48,7 +53,7 @@ namespace SassTypes
   NAN_METHOD(Null::New) {
 
     if (info.IsConstructCall()) {
-      if (constructor_locked) {
+      if (constructor_locked.get()) {
         return Nan::ThrowTypeError("Cannot instantiate SassNull");
       }
     }
@@ -2,6 +2,7 @@
 #define SASS_TYPES_NULL_H
 
 #include <nan.h>
+#include "../per_isolate.h"
 #include "value.h"
 
 namespace SassTypes
@@ -21,8 +22,11 @@ namespace SassTypes
 
       Nan::Persistent<v8::Object> js_object;
 
-      static Nan::Persistent<v8::Function> constructor;
-      static bool constructor_locked;
+      struct Singleton;
+
+      static PerIsolate<Singleton> singleton;
+      static PerIsolate<Nan::Persistent<v8::Function>> constructor;
+      static PerIsolate<bool> constructor_locked;
   };
 }
 
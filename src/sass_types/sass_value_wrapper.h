@@ -4,6 +4,7 @@
 #include <stdexcept>
 #include <vector>
 #include <nan.h>
+#include "../per_isolate.h"
 #include "value.h"
 #include "factory.h"
 
@@ -32,12 +33,12 @@ namespace SassTypes
       static T* unwrap(v8::Local<v8::Object>);
 
     private:
-      static Nan::Persistent<v8::Function> constructor;
+      static PerIsolate<Nan::Persistent<v8::Function>> constructor;
       Nan::Persistent<v8::Object> js_object;
   };
 
   template <class T>
-  Nan::Persistent<v8::Function> SassValueWrapper<T>::constructor;
+  PerIsolate<Nan::Persistent<v8::Function>> SassValueWrapper<T>::constructor;
 
   template <class T>
   SassValueWrapper<T>::SassValueWrapper(Sass_Value* v) {
@@ -80,11 +81,13 @@ namespace SassTypes
 
   template <class T>
   v8::Local<v8::Function> SassValueWrapper<T>::get_constructor() {
-    if (constructor.IsEmpty()) {
-      constructor.Reset(Nan::GetFunction(T::get_constructor_template()).ToLocalChecked());
+    Nan::Persistent<v8::Function>& cons = constructor.get();
+
+    if (cons.IsEmpty()) {
+      cons.Reset(Nan::GetFunction(T::get_constructor_template()).ToLocalChecked());
     }
 
-    return Nan::New(constructor);
+    return Nan::New(cons);
   }
 
   template <class T>
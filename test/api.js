@@ -2,7 +2,9 @@
 
 var assert = require('assert'),
   fs = require('fs'),
+  os = require('os'),
   path = require('path'),
+  rimraf = require('rimraf'),
   read = fs.readFileSync,
   sassPath = process.env.NODESASS_COV
       ? require.resolve('../lib-cov')
@@ -244,6 +246,207 @@ describe('api', function() {
         done();
       });
     });
+
+    it('should compile sass to css with data as a Buffer', function(done) {
+      var src = read(fixture('simple/index.scss'));
+      var expected = read(fixture('simple/expected.css'), 'utf8').trim();
+
+      sass.render({
+        data: src
+      }, function(error, result) {
+        assert.equal(result.css.toString().trim(), expected.replace(/\r\n/g, '\n'));
+        done();
+      });
+    });
+
+    it('should resolve imports from include paths with includePathCache', function(done) {
+      var src = read(fixture('include-path/index.scss'), 'utf8');
+      var expected = read(fixture('include-path/expected.css'), 'utf8').trim();
+
+      sass.render({
+        data: src,
+        includePaths: [
+          fixture('include-path/functions'),
+          fixture('include-path/lib')
+        ],
+        includePathCache: true
+      }, function(error, result) {
+        assert(!error);
+        assert.equal(result.css.toString().trim(), expected.replace(/\r\n/g, '\n'));
+        done();
+      });
+    });
+
+    it('should answer imports from the include path cache until it is revalidated', function(done) {
+      var root = fs.mkdtempSync(path.join(os.tmpdir(), 'node-sass-')),
+        first = path.join(root, 'first'),
+        second = path.join(root, 'second'),
+        past = new Date(2000, 0, 1),
+        later = new Date(2001, 0, 1);
+
+      function render(data, cb) {
+        sass.render({
+          data: data,
+          includePaths: [first, second],
+          includePathCache: true,
+          outputStyle: 'compressed'
+        }, function(error, result) {
+          assert(!error);
+          cb(result.css.toString().trim());
+        });
+      }
+
+      // add a file without changing the modification time of its directory
+      function addUnnoticed(file, contents, mtime) {
+        fs.writeFileSync(path.join(first, file), contents);
+        fs.utimesSync(first, mtime, mtime);
+      }
+
+      fs.mkdirSync(first);
+      fs.mkdirSync(second);
+      fs.writeFileSync(path.join(second, '_colors.scss'), 'a { color: blue; }');
+      fs.writeFileSync(path.join(second, '_sizes.scss'), 'a { width: 1px; }');
+      fs.utimesSync(first, past, past);
+      sass.clearIncludePathCache();
+
+      render('@import "colors";', function(css) {
+        assert.equal(css, 'a{color:blue}');
+        addUnnoticed('_colors.scss', 'a { color: red; }', past);
+
+        render('@import "colors";', function(css) {
+          assert.equal(css, 'a{color:blue}');
+          fs.utimesSync(first, later, later);
+
+          render('@import "colors";', function(css) {
+            assert.equal(css, 'a{color:red}');
+            addUnnoticed('_sizes.scss', 'a { width: 2px; }', later);
+
+            render('@import "sizes";', function(css) {
+              assert.equal(css, 'a{width:1px}');
+              sass.clearIncludePathCache();
+
+              render('@import "sizes";', function(css) {
+                assert.equal(css, 'a{width:2px}');
+                rimraf.sync(root);
+                done();
+              });
+            });
+          });
+        });
+      });
+    });
+
+    it('should import indented syntax partials with includePathCache', function(done) {
+      var expected = read(fixture('include-path-indented/expected.css'), 'utf8').trim();
+
+      sass.render({
+        file: fixture('include-path-indented/index.scss'),
+        includePaths: [fixture('include-path-indented/lib')],
+        includePathCache: true
+      }, function(error, result) {
+        assert(!error);
+        assert.equal(result.css.toString().trim(), expected.replace(/\r\n/g, '\n'));
+        done();
+      });
+    });
+
+    it('should report included files with includePathCache', function(done) {
+      var expected = [
+        fixture('include-files/bar.scss').replace(/\\/g, '/'),
+        fixture('include-files/foo.scss').replace(/\\/g, '/'),
+        fixture('include-files/index.scss').replace(/\\/g, '/')
+      ];
+
+      sass.clearIncludePathCache();
+      sass.render({
+        file: fixture('include-files/index.scss'),
+        includePathCache: true
+      }, function(error, result) {
+        assert(!error);
+        assert.deepEqual(result.stats.includedFiles.sort(), expected.sort());
+        done();
+      });
+    });
+
+    it('should resolve node_modules and aliased imports natively', function(done) {
+      var expected = read(fixture('native-importers/expected.css'), 'utf8').trim();
+
+      sass.render({
+        file: fixture('native-importers/index.scss'),
+        nodeModules: true,
+        importAliases: {
+          alias: fixture('native-importers/local')
+        }
+      }, function(error, result) {
+        assert(!error);
+        assert.equal(result.css.toString().trim(), expected.replace(/\r\n/g, '\n'));
+        done();
+      });
+    });
+
+    it('should optimize compressed output', function(done) {
+      sass.render({
+        data: '.a { margin: 0px; } .a { padding: 1px; } .b { color: #aabbcc; }',
+        outputStyle: 'compressed',
+        optimize: true
+      }, function(error, result) {
+        assert(!error);
+        assert.equal(result.css.toString().trim(), '.a{margin:0;padding:1px}.b{color:#abc}');
+        assert(result.stats.bytesSaved > 0);
+        done();
+      });
+    });
+
+    it('should share one compile between identical concurrent renders', function(done) {
+      var results = [];
+
+      function collect(error, result) {
+        assert(!error);
+        results.push(result);
+
+        if (results.length === 2) {
+          assert.strictEqual(results[0], results[1]);
+          done();
+        }
+      }
+
+      sass.render({ file: fixture('simple/index.scss'), coalesce: true }, collect);
+      sass.render({ file: fixture('simple/index.scss'), coalesce: true }, collect);
+    });
+
+    it('should not share compiles unless coalesce is set', function(done) {
+      var results = [];
+
+      function collect(error, result) {
+        assert(!error);
+        results.push(result);
+
+        if (results.length === 2) {
+          assert.notStrictEqual(results[0], results[1]);
+          done();
+        }
+      }
+
+      sass.render({ file: fixture('simple/index.scss') }, collect);
+      sass.render({ file: fixture('simple/index.scss') }, collect);
+    });
+
+    it('should not share compiles between renders with different options', function(done) {
+      var results = [];
+
+      function collect(error, result) {
+        assert(!error);
+        results.push(result);
+
+        if (results.length === 2) {
+          assert.notStrictEqual(results[0], results[1]);
+          done();
+        }
+      }
+
+      sass.render({ file: fixture('simple/index.scss'), coalesce: true }, collect);
+      sass.render({ file: fixture('simple/index.scss'), coalesce: true, outputStyle: 'compressed' }, collect);
+    });
   });
 
   describe('.render(importer)', function() {
@@ -321,6 +524,63 @@ describe('api', function() {
       });
     });
 
+    it('should override imports with contents returned as a Buffer', function(done) {
+      sass.render({
+        data: src,
+        importer: function(url, prev, done) {
+          done({
+            file: '/some/other/path.scss',
+            contents: new Buffer('div {color: yellow;}')
+          });
+        }
+      }, function(error, result) {
+        assert.equal(result.css.toString().trim(), 'div {\n  color: yellow; }\n\ndiv {\n  color: yellow; }');
+        done();
+      });
+    });
+
+    it('should call async importers concurrently with prefetchImports', function(done) {
+      var running = 0, maxRunning = 0;
+
+      sass.render({
+        data: src,
+        prefetchImports: true,
+        importer: function(url, prev, done) {
+          maxRunning = Math.max(maxRunning, ++running);
+
+          setTimeout(function() {
+            running--;
+            done({
+              contents: 'div {color: yellow;}'
+            });
+          }, 10);
+        }
+      }, function(error, result) {
+        assert.equal(maxRunning, 2);
+        assert.equal(result.css.toString().trim(), 'div {\n  color: yellow; }\n\ndiv {\n  color: yellow; }');
+        done();
+      });
+    });
+
+    it('should not prefetch imports in comments or strings', function(done) {
+      var urls = [];
+
+      sass.render({
+        data: '@import "a"; // @import "b";\n$x: "@import \'c\'";\ndiv { content: $x; }',
+        prefetchImports: true,
+        importer: function(url, prev, done) {
+          urls.push(url);
+          done({
+            contents: 'div {color: yellow;}'
+          });
+        }
+      }, function(error) {
+        assert.ifError(error);
+        assert.deepEqual(urls, ['a']);
+        done();
+      });
+    });
+
     it('should should resolve imports depth first', function (done) {
       var actualImportOrder = [];
       var expectedImportOrder = [
@@ -639,7 +899,7 @@ describe('api', function() {
       sass.render({
         data: src,
         importer: function() {
-          return { contents: new Buffer('i am not a string!') };
+          return { contents: ['i am not a string!'] };
         }
       }, function(error) {
         assert(/returned value of `contents` must be a string/.test(error.message));
@@ -1198,6 +1458,52 @@ describe('api', function() {
     });
   });
 
+  describe('.renderVariants(options, variants, callback)', function() {
+    it('should compile a stylesheet once per set of variables', function(done) {
+      sass.renderVariants({
+        data: '$color: red !default; a { color: $color; }',
+        outputStyle: 'compressed'
+      }, [{ color: 'blue' }, { $color: 'green' }, {}], function(error, results) {
+        assert(!error);
+        assert.deepEqual(results.map(function(result) {
+          return result.css.toString().trim();
+        }), ['a{color:blue}', 'a{color:green}', 'a{color:red}']);
+        done();
+      });
+    });
+
+    it('should compile files starting with a byte order mark', function(done) {
+      sass.renderVariants({
+        file: fixture('variants/bom.scss'),
+        outputStyle: 'compressed'
+      }, [{ color: 'blue' }], function(error, results) {
+        assert(!error);
+        assert.equal(results[0].css.toString().trim(), 'a{color:blue}');
+        done();
+      });
+    });
+
+    it('should report the first error', function(done) {
+      sass.renderVariants({
+        data: 'a { width: $width; }'
+      }, [{ width: '1px' }, {}], function(error) {
+        assert(/Undefined variable/.test(error.message));
+        done();
+      });
+    });
+
+    it('should report an unreadable file like a compile error', function(done) {
+      sass.renderVariants({
+        file: fixture('variants/missing.scss')
+      }, [{}], function(error) {
+        assert.equal(error.status, 3);
+        assert(/File to read not found or unreadable/.test(error.message));
+        assert(/^Error: /.test(error.formatted));
+        done();
+      });
+    });
+  });
+
   describe('.render({stats: {}})', function() {
     var start = Date.now();
 
@@ -1299,6 +1605,15 @@ describe('api', function() {
       done();
     });
 
+    it('should compile sass to css with data as a Buffer', function(done) {
+      var src = read(fixture('simple/index.scss'));
+      var expected = read(fixture('simple/expected.css'), 'utf8').trim();
+      var result = sass.renderSync({ data: src });
+
+      assert.equal(result.css.toString().trim(), expected.replace(/\r\n/g, '\n'));
+      done();
+    });
+
     it('should compile sass to css with outFile set to absolute url', function(done) {
       var result = sass.renderSync({
         file: fixture('simple/index.scss'),
@@ -1365,6 +1680,18 @@ describe('api', function() {
       done();
     });
 
+    it('should not optimize output which is not compressed', function(done) {
+      var result = sass.renderSync({
+        data: '.a { margin: 0px; } .a { padding: 1px; }',
+        outputStyle: 'expanded',
+        optimize: true
+      });
+
+      assert(result.css.toString().indexOf('0px') !== -1);
+      assert.strictEqual(result.stats.bytesSaved, undefined);
+      done();
+    });
+
     it('should NOT compile empty data string', function(done) {
       assert.throws(function() {
         sass.renderSync({ data: '' });
@@ -1391,6 +1718,80 @@ describe('api', function() {
     });
   });
 
+  describe('.renderSync({optimize: true})', function() {
+    function optimize(data) {
+      return sass.renderSync({
+        data: data,
+        outputStyle: 'compressed',
+        optimize: true
+      });
+    }
+
+    it('should report the bytes saved', function(done) {
+      var result = optimize('.a { margin: 0px; } .a { padding: 0px; }');
+
+      assert.equal(result.css.toString().trim(), '.a{margin:0;padding:0}');
+      assert(result.stats.bytesSaved > 0);
+      done();
+    });
+
+    it('should not rewrite strings', function(done) {
+      var css = optimize('.a { content: "#aabbcc 0px"; } .b { content: \'0px\'; }').css.toString();
+
+      assert(css.indexOf('"#aabbcc 0px"') !== -1);
+      assert(css.indexOf('\'0px\'') !== -1 || css.indexOf('"0px"') !== -1);
+      done();
+    });
+
+    it('should not rewrite the arguments of url() and math functions', function(done) {
+      var css = optimize([
+        '.a { background: url(/0px.png); }',
+        '.b { width: calc(0px + 10%); }',
+        '.c { width: unquote("max(0px, 50%)"); }',
+        '.d { width: unquote("min(0px, 50%)"); }',
+        '.e { width: clamp(0px, 1vw, 10px); }'
+      ].join('\n')).css.toString();
+
+      assert(css.indexOf('url(/0px.png)') !== -1);
+      assert(/calc\(0px ?\+ ?10%\)/.test(css));
+      assert(css.indexOf('max(0px, 50%)') !== -1);
+      assert(css.indexOf('min(0px, 50%)') !== -1);
+      assert(/clamp\(0px, ?1vw, ?10px\)/.test(css));
+      done();
+    });
+
+    it('should optimize rules nested in @media and @keyframes', function(done) {
+      var css = optimize([
+        '@media screen { .a { margin: 0px; } .a { padding: 1px; } }',
+        '@keyframes spin { from { left: 0px; } to { left: 0px; } }'
+      ].join('\n')).css.toString().trim();
+
+      assert.equal(css, '@media screen{.a{margin:0;padding:1px}}@keyframes spin{from,to{left:0}}');
+      done();
+    });
+
+    it('should keep preserved comments', function(done) {
+      var css = optimize('/*! license */\n.a { color: red; } .a { top: 0px; }').css.toString();
+
+      assert.equal(css.indexOf('/*! license */'), 0);
+      assert(css.indexOf('.a{color:red;top:0}') !== -1);
+      done();
+    });
+
+    it('should not group selectors with pseudo classes or attributes', function(done) {
+      var css = optimize([
+        'a:focus-visible { outline: 0; }',
+        'a:hover { outline: 0; }',
+        '[hidden] { top: 0; }',
+        '.a { top: 0; }',
+        '.b { top: 0; }'
+      ].join('\n')).css.toString().trim();
+
+      assert.equal(css, 'a:focus-visible{outline:0}a:hover{outline:0}[hidden]{top:0}.a,.b{top:0}');
+      done();
+    });
+  });
+
   describe('.renderSync(importer)', function() {
     var src = read(fixture('include-files/index.scss'), 'utf8');
 
@@ -1582,7 +1983,7 @@ describe('api', function() {
         sass.renderSync({
           data: src,
           importer: function() {
-            return { contents: new Buffer('i am not a string!') };
+            return { contents: ['i am not a string!'] };
           }
         });
       }, /returned value of `contents` must be a string/);
@@ -1824,6 +2225,80 @@ describe('api', function() {
     });
   });
 
+  describe('worker_threads', function() {
+    it('should render with custom functions in several workers at once', function(done) {
+      var threads, pending = 2;
+
+      try {
+        threads = require('worker_threads');
+      } catch (e) {
+        return this.skip();
+      }
+
+      var source = [
+        'var sass = require(' + JSON.stringify(sassPath) + ');',
+        'var result = sass.renderSync({',
+        '  data: "div { color: foo(); }",',
+        '  functions: { "foo()": function() { return new sass.types.Color(0xffff0000); } }',
+        '});',
+        'require("worker_threads").parentPort.postMessage(result.css.toString());'
+      ].join('\n');
+
+      function onMessage(css) {
+        assert.equal(css.trim(), 'div {\n  color: red; }');
+
+        if (--pending === 0) {
+          done();
+        }
+      }
+
+      new threads.Worker(source, { eval: true }).on('message', onMessage);
+      new threads.Worker(source, { eval: true }).on('message', onMessage);
+    });
+
+    it('should render asynchronously with importers and functions in several workers at once', function(done) {
+      var threads, pending = 2;
+
+      try {
+        threads = require('worker_threads');
+      } catch (e) {
+        return this.skip();
+      }
+
+      var source = [
+        'var sass = require(' + JSON.stringify(sassPath) + ');',
+        'sass.render({',
+        '  data: "@import \'colors\'; div { color: foo($color); }",',
+        '  importer: function(url, prev, done) {',
+        '    setTimeout(function() {',
+        '      done({ contents: "$color: #f00;" });',
+        '    }, 10);',
+        '  },',
+        '  functions: {',
+        '    "foo($color)": function(color, done) {',
+        '      setTimeout(function() {',
+        '        done(new sass.types.Color(color.getR(), 0, 0x10));',
+        '      }, 10);',
+        '    }',
+        '  }',
+        '}, function(error, result) {',
+        '  require("worker_threads").parentPort.postMessage(error ? error.message : result.css.toString());',
+        '});'
+      ].join('\n');
+
+      function onMessage(css) {
+        assert.equal(css.trim(), 'div {\n  color: #ff0010; }');
+
+        if (--pending === 0) {
+          done();
+        }
+      }
+
+      new threads.Worker(source, { eval: true }).on('message', onMessage);
+      new threads.Worker(source, { eval: true }).on('message', onMessage);
+    });
+  });
+
   describe('.info', function() {
     var package = require('../package.json'),
       info = sass.info;
@@ -1,5 +1,6 @@
 var assert = require('assert'),
   fs = require('fs'),
+  os = require('os'),
   path = require('path'),
   read = require('fs').readFileSync,
   glob = require('glob'),
@@ -801,4 +802,92 @@ describe('cli', function() {
       });
     });
   });
+
+  describe('node-sass --server', function() {
+    var socket = process.platform === 'win32' ?
+      '\\\\.\\pipe\\node-sass-test-' + process.pid :
+      path.join(os.tmpdir(), 'node-sass-test-' + process.pid + '.sock');
+    var server;
+
+    before(function(done) {
+      server = spawn(cli, ['--server', socket]);
+      server.stderr.setEncoding('utf8');
+      server.stderr.once('data', function() {
+        done();
+      });
+    });
+
+    after(function() {
+      server.kill();
+    });
+
+    it('should compile a file on the server', function(done) {
+      var src = fixture('simple/index.scss');
+      var expected = read(fixture('simple/expected.css'), 'utf8').trim();
+      var bin = spawn(cli, ['--connect', socket, src]);
+      var output = '';
+
+      bin.stdout.setEncoding('utf8');
+      bin.stdout.on('data', function(data) {
+        output += data;
+      });
+
+      bin.once('close', function(code) {
+        assert.equal(code, 0);
+        assert.equal(output.trim(), expected.replace(/\r\n/g, '\n'));
+        done();
+      });
+    });
+
+    it('should compile data from stdin on the server', function(done) {
+      var src = fs.createReadStream(fixture('simple/index.scss'));
+      var expected = read(fixture('simple/expected.css'), 'utf8').trim();
+      var bin = spawn(cli, ['--connect', socket]);
+      var output = '';
+
+      bin.stdout.setEncoding('utf8');
+      bin.stdout.on('data', function(data) {
+        output += data;
+      });
+
+      bin.once('close', function(code) {
+        assert.equal(code, 0);
+        assert.equal(output.trim(), expected.replace(/\r\n/g, '\n'));
+        done();
+      });
+
+      src.pipe(bin.stdin);
+    });
+
+    it('should compile indented syntax partials on the server', function(done) {
+      var src = fixture('include-path-indented/index.scss');
+      var expected = read(fixture('include-path-indented/expected.css'), 'utf8').trim();
+      var bin = spawn(cli, [
+        '--connect', socket, src,
+        '--include-path', fixture('include-path-indented/lib'),
+        '--include-path-cache'
+      ]);
+      var output = '';
+
+      bin.stdout.setEncoding('utf8');
+      bin.stdout.on('data', function(data) {
+        output += data;
+      });
+
+      bin.once('close', function(code) {
+        assert.equal(code, 0);
+        assert.equal(output.trim(), expected.replace(/\r\n/g, '\n'));
+        done();
+      });
+    });
+
+    it('should report errors with the exit status', function(done) {
+      var bin = spawn(cli, ['--connect', socket, fixture('invalid/index.scss')]);
+
+      bin.once('close', function(code) {
+        assert.equal(code, 1);
+        done();
+      });
+    });
+  });
 });